@@ -0,0 +1,100 @@
+#include "ActorSensorCache.h"
+#include "RaySenseLogic.h"
+#include "Trace.h"
+#include <algorithm>
+
+void ActorSensorCache::Configure(bool a_enabled, float a_ttl,
+                                 float a_distanceScale,
+                                 std::uint32_t a_maxPerFrame,
+                                 float a_idleSeconds) {
+  _ttl = std::max(0.0f, a_ttl);
+  _distanceScale = std::max(1.0f, a_distanceScale);
+  _maxPerFrame = a_maxPerFrame;
+  _idleSeconds = std::max(0.5f, a_idleSeconds);
+  _enabled.store(a_enabled, std::memory_order_relaxed);
+
+  if (a_enabled) {
+    SKSE::log::info("ActorSensorCache: Enabled (TTL {:.2f}s, {} per frame, "
+                    "{} slots)",
+                    _ttl, _maxPerFrame, ActorSensorTable::CAPACITY);
+  }
+}
+
+bool ActorSensorCache::GetValue(RE::TESObjectREFR *a_refr, Channel a_channel,
+                                float &a_value) {
+  if (!IsEnabled() || !a_refr || !a_refr->Is(RE::FormType::ActorCharacter))
+    return false;
+
+  const auto handle = a_refr->GetHandle().native_handle();
+  if (!handle)
+    return false;
+  return _table.Read(handle, a_channel, a_value);
+}
+
+bool ActorSensorCache::StoreValues(RE::Actor *a_actor,
+                                   const ActorSensorTable::Values &a_values,
+                                   ChannelMask a_channels) {
+  if (!IsEnabled() || !a_actor)
+    return false;
+
+  const auto handle = a_actor->GetHandle().native_handle();
+  return handle && _table.Store(handle, a_values, a_channels);
+}
+
+RE::NiPointer<RE::Actor>
+ActorSensorCache::LookupActor(ActorSensorTable::Handle a_handle) {
+  RE::NiPointer<RE::TESObjectREFR> refr;
+  if (!RE::TESObjectREFR::LookupByHandle(a_handle, refr) || !refr)
+    return nullptr;
+  return RE::NiPointer<RE::Actor>(refr->As<RE::Actor>());
+}
+
+void ActorSensorCache::Update(float a_delta) {
+  if (!IsEnabled())
+    return;
+
+  Trace::Scope scope("ActorSensorCache");
+  _now += a_delta;
+  _table.BeginUpdate(_now);
+  _table.EvictIdle(_idleSeconds);
+
+  RE::NiPoint3 cameraPos;
+  auto *camera = RE::PlayerCamera::GetSingleton();
+  if (camera && camera->cameraRoot) {
+    cameraPos = camera->cameraRoot->world.translate;
+  } else if (auto *player = RE::PlayerCharacter::GetSingleton()) {
+    cameraPos = player->GetPosition();
+  }
+
+  // Evict on unload and refresh the camera distance used for priority
+  _unloaded.clear();
+  _table.ForEach([&](std::uint32_t a_slot,
+                     ActorSensorTable::Handle a_handle) {
+    auto actor = LookupActor(a_handle);
+    if (!actor || !actor->Is3DLoaded() || actor->IsDisabled()) {
+      _unloaded.push_back(a_slot);
+      return;
+    }
+    _table.SetDistance(a_slot, cameraPos.GetDistance(actor->GetPosition()));
+  });
+  for (auto slot : _unloaded)
+    _table.Evict(slot);
+
+  _table.SelectDue(_ttl, _distanceScale, _maxPerFrame, _due);
+  if (_due.empty())
+    return;
+
+  auto *logic = RaySenseLogic::GetSingleton();
+  RaySenseLogic::SensorValues values{};
+  for (auto slot : _due) {
+    if (auto actor = LookupActor(_table.GetHandle(slot))) {
+      logic->SenseActor(actor.get(), values);
+      _table.Commit(slot, values);
+    }
+  }
+}
+
+void ActorSensorCache::Reset() {
+  _table.Clear();
+  _now = 0.0f;
+}
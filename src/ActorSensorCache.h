@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ActorSensorTable.h"
+#include "PCH.h"
+#include "SensorChannels.h"
+#include <atomic>
+#include <vector>
+
+// On-demand sensing for NPCs, followers and creatures.
+// The first condition evaluated for an actor queues it; the main thread then
+// senses a few actors per frame, refreshing each one after a TTL that grows
+// with distance from the camera. Actors are evicted once their 3D unloads or
+// no condition has read them for a while.
+class ActorSensorCache {
+public:
+  static ActorSensorCache *GetSingleton() {
+    static ActorSensorCache singleton;
+    return &singleton;
+  }
+
+  void Configure(bool a_enabled, float a_ttl, float a_distanceScale,
+                 std::uint32_t a_maxPerFrame, float a_idleSeconds);
+  static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+  // Any thread. False until a_refr has been sensed at least once.
+  bool GetValue(RE::TESObjectREFR *a_refr, Channel a_channel, float &a_value);
+  // Any thread. Overwrites the masked channels of an actor already being
+  // sensed; false if no condition has asked for it yet.
+  bool StoreValues(RE::Actor *a_actor, const ActorSensorTable::Values &a_values,
+                   ChannelMask a_channels);
+
+  // Main thread, once per player update.
+  void Update(float a_delta);
+  void Reset();
+
+private:
+  ActorSensorCache() = default;
+  ~ActorSensorCache() = default;
+  ActorSensorCache(const ActorSensorCache &) = delete;
+  ActorSensorCache(const ActorSensorCache &&) = delete;
+  ActorSensorCache &operator=(const ActorSensorCache &) = delete;
+  ActorSensorCache &operator=(const ActorSensorCache &&) = delete;
+
+  static RE::NiPointer<RE::Actor>
+  LookupActor(ActorSensorTable::Handle a_handle);
+
+  static inline std::atomic<bool> _enabled{false};
+  float _ttl{0.1f};
+  float _distanceScale{2048.0f};
+  std::uint32_t _maxPerFrame{4};
+  float _idleSeconds{5.0f};
+
+  ActorSensorTable _table;
+  float _now{0.0f};
+  std::vector<std::uint32_t> _due;
+  std::vector<std::uint32_t> _unloaded;
+};
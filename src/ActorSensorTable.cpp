@@ -0,0 +1,169 @@
+#include "ActorSensorTable.h"
+#include <algorithm>
+#include <limits>
+
+ActorSensorTable::ActorSensorTable() { Clear(); }
+
+bool ActorSensorTable::Read(Handle a_handle, Channel a_channel,
+                            float &a_value) {
+  {
+    std::shared_lock lock(_slotsLock);
+    if (auto it = _slots.find(a_handle); it != _slots.end()) {
+      const auto slot = it->second;
+      _lastRead[slot].store(_now.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+      if (!_sensed[slot].load(std::memory_order_acquire))
+        return false;
+      a_value =
+          _values[ToIndex(a_channel)][slot].load(std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  // Duplicates are fine; BeginUpdate skips handles that already have a slot.
+  std::scoped_lock lock(_requestsLock);
+  if (_requests.size() < CAPACITY)
+    _requests.push_back(a_handle);
+  return false;
+}
+
+bool ActorSensorTable::Store(Handle a_handle, const Values &a_values,
+                             ChannelMask a_channels) {
+  std::shared_lock lock(_slotsLock);
+  auto it = _slots.find(a_handle);
+  if (it == _slots.end())
+    return false;
+
+  const auto slot = it->second;
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    if (a_channels & ToMask(static_cast<Channel>(i)))
+      _values[i][slot].store(a_values[i], std::memory_order_relaxed);
+  }
+  return true;
+}
+
+void ActorSensorTable::BeginUpdate(float a_now) {
+  _now.store(a_now, std::memory_order_relaxed);
+
+  std::vector<Handle> requests;
+  {
+    std::scoped_lock lock(_requestsLock);
+    requests.swap(_requests);
+  }
+  for (auto handle : requests)
+    Insert(handle);
+}
+
+void ActorSensorTable::Insert(Handle a_handle) {
+  if (_slots.contains(a_handle))
+    return;
+  if (_free.empty()) {
+    ++_dropped;
+    return;
+  }
+
+  const auto slot = _free.back();
+  _free.pop_back();
+
+  _handles[slot] = a_handle;
+  _lastSensed[slot] = 0.0f;
+  _distance[slot] = 0.0f;
+  _sensed[slot].store(false, std::memory_order_relaxed);
+  _lastRead[slot].store(_now.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+  _active.push_back(slot);
+
+  std::unique_lock lock(_slotsLock);
+  _slots.emplace(a_handle, slot);
+}
+
+void ActorSensorTable::Evict(std::uint32_t a_slot) {
+  {
+    std::unique_lock lock(_slotsLock);
+    _slots.erase(_handles[a_slot]);
+  }
+  _sensed[a_slot].store(false, std::memory_order_relaxed);
+  _handles[a_slot] = 0;
+
+  if (auto it = std::find(_active.begin(), _active.end(), a_slot);
+      it != _active.end()) {
+    *it = _active.back();
+    _active.pop_back();
+    _free.push_back(a_slot);
+  }
+}
+
+std::size_t ActorSensorTable::EvictIdle(float a_idleSeconds) {
+  const float cutoff = _now.load(std::memory_order_relaxed) - a_idleSeconds;
+
+  std::size_t evicted = 0;
+  for (std::size_t i = _active.size(); i-- > 0;) {
+    const auto slot = _active[i];
+    if (_lastRead[slot].load(std::memory_order_relaxed) < cutoff) {
+      Evict(slot);
+      ++evicted;
+    }
+  }
+  return evicted;
+}
+
+void ActorSensorTable::SelectDue(float a_ttl, float a_distanceScale,
+                                 std::size_t a_max,
+                                 std::vector<std::uint32_t> &a_out) {
+  a_out.clear();
+  _candidates.clear();
+
+  const float now = _now.load(std::memory_order_relaxed);
+  const float scale = std::max(a_distanceScale, 1.0f);
+  for (auto slot : _active) {
+    if (!_sensed[slot].load(std::memory_order_relaxed)) {
+      _candidates.push_back({std::numeric_limits<float>::infinity(),
+                             _distance[slot], slot});
+      continue;
+    }
+
+    const float ttl = a_ttl * (1.0f + _distance[slot] / scale);
+    const float age = now - _lastSensed[slot];
+    if (age >= ttl)
+      _candidates.push_back({ttl > 0.0f ? age / ttl : age, _distance[slot],
+                             slot});
+  }
+
+  const auto count = std::min(a_max, _candidates.size());
+  std::partial_sort(_candidates.begin(), _candidates.begin() + count,
+                    _candidates.end(),
+                    [](const Candidate &a_lhs, const Candidate &a_rhs) {
+                      if (a_lhs.urgency != a_rhs.urgency)
+                        return a_lhs.urgency > a_rhs.urgency;
+                      return a_lhs.distance < a_rhs.distance;
+                    });
+  for (std::size_t i = 0; i < count; ++i)
+    a_out.push_back(_candidates[i].slot);
+}
+
+void ActorSensorTable::Commit(std::uint32_t a_slot, const Values &a_values) {
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i)
+    _values[i][a_slot].store(a_values[i], std::memory_order_relaxed);
+  _lastSensed[a_slot] = _now.load(std::memory_order_relaxed);
+  _sensed[a_slot].store(true, std::memory_order_release);
+}
+
+void ActorSensorTable::Clear() {
+  {
+    std::unique_lock lock(_slotsLock);
+    _slots.clear();
+  }
+  {
+    std::scoped_lock lock(_requestsLock);
+    _requests.clear();
+  }
+
+  _active.clear();
+  _free.clear();
+  for (auto slot = static_cast<std::uint32_t>(CAPACITY); slot-- > 0;) {
+    _sensed[slot].store(false, std::memory_order_relaxed);
+    _handles[slot] = 0;
+    _free.push_back(slot);
+  }
+  _dropped = 0;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+// Kept free of game headers so host tools can drive the scheduler directly.
+#include "SensorChannels.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+// Handle-indexed sensor results for non-player actors.
+// Storage is a fixed-capacity structure of arrays: every channel is its own
+// column, so a condition read touches one float and a commit writes one
+// contiguous row per channel. Graph threads only read and queue requests;
+// slot allocation, scheduling and eviction happen on the main thread.
+class ActorSensorTable {
+public:
+  using Handle = std::uint32_t;
+  using Values = std::array<float, CHANNEL_COUNT>;
+
+  static constexpr std::size_t CAPACITY = 256;
+
+  ActorSensorTable();
+
+  // --- Any thread ---
+
+  // Reads a committed value. Unknown handles are queued for sensing and
+  // return false until the main thread has sensed them once.
+  bool Read(Handle a_handle, Channel a_channel, float &a_value);
+
+  // Overwrites the masked channels of a handle that already has a slot.
+  // False (and nothing stored) for unknown handles.
+  bool Store(Handle a_handle, const Values &a_values, ChannelMask a_channels);
+
+  // --- Main thread ---
+
+  // Advances the table clock and moves queued requests into free slots.
+  void BeginUpdate(float a_now);
+
+  // Calls a_fn(slot, handle) for every occupied slot.
+  template <class Fn> void ForEach(Fn &&a_fn) const {
+    for (auto slot : _active)
+      a_fn(slot, _handles[slot]);
+  }
+
+  [[nodiscard]] Handle GetHandle(std::uint32_t a_slot) const {
+    return _handles[a_slot];
+  }
+  void SetDistance(std::uint32_t a_slot, float a_distance) {
+    _distance[a_slot] = a_distance;
+  }
+  void Evict(std::uint32_t a_slot);
+  // Drops actors no condition has read for a_idleSeconds
+  std::size_t EvictIdle(float a_idleSeconds);
+
+  // Picks up to a_max slots whose TTL ran out, most overdue first. The TTL
+  // grows linearly with distance: a_ttl * (1 + distance / a_distanceScale).
+  // Slots that were never sensed always come first, nearest first.
+  void SelectDue(float a_ttl, float a_distanceScale, std::size_t a_max,
+                 std::vector<std::uint32_t> &a_out);
+
+  void Commit(std::uint32_t a_slot, const Values &a_values);
+  void Clear();
+
+  [[nodiscard]] std::size_t Size() const { return _active.size(); }
+  [[nodiscard]] std::size_t Dropped() const { return _dropped; }
+
+private:
+  void Insert(Handle a_handle);
+
+  std::atomic<float> _now{0.0f};
+
+  // Handle -> slot, written on the main thread under an exclusive lock
+  mutable std::shared_mutex _slotsLock;
+  std::unordered_map<Handle, std::uint32_t> _slots;
+
+  std::mutex _requestsLock;
+  std::vector<Handle> _requests;
+
+  // Columns. Atomics are shared with readers, plain arrays are main-thread.
+  std::array<std::array<std::atomic<float>, CAPACITY>, CHANNEL_COUNT>
+      _values{};
+  std::array<std::atomic<bool>, CAPACITY> _sensed{};
+  std::array<std::atomic<float>, CAPACITY> _lastRead{};
+  std::array<Handle, CAPACITY> _handles{};
+  std::array<float, CAPACITY> _lastSensed{};
+  std::array<float, CAPACITY> _distance{};
+
+  std::vector<std::uint32_t> _active;
+  std::vector<std::uint32_t> _free;
+  std::size_t _dropped{0}; // Requests refused because the table was full
+
+  struct Candidate {
+    float urgency;
+    float distance;
+    std::uint32_t slot;
+  };
+  std::vector<Candidate> _candidates;
+};
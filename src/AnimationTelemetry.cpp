@@ -0,0 +1,145 @@
+#include "AnimationTelemetry.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <vector>
+
+void AnimationTelemetry::Configure(bool a_enabled, float a_sampleInterval) {
+  _sampleInterval = std::max(0.016f, a_sampleInterval);
+  _enabled.store(a_enabled, std::memory_order_relaxed);
+
+  if (a_enabled) {
+    SKSE::log::info("AnimationTelemetry: Enabled (sample every {:.3f}s)",
+                    _sampleInterval);
+  }
+}
+
+void AnimationTelemetry::Update(float a_delta) {
+  if (!IsEnabled() || a_delta <= 0.0f)
+    return;
+
+  _sessionTime += a_delta;
+  _sampleTimer += a_delta;
+  if (_sampleTimer < _sampleInterval)
+    return;
+
+  const float elapsed = _sampleTimer;
+  _sampleTimer = 0.0f;
+
+  auto *tracker = ClipTracker::GetSingleton();
+  const auto &clips = tracker->GetClips();
+  if (tracker->GetGeneration() != _generation) {
+    _generation = tracker->GetGeneration();
+    _states.clear();
+    _history.clear();
+  }
+
+  // Time a channel spends feeding at least one live clip is the denominator
+  // of its switches-per-minute figure.
+  ChannelMask activeChannels = 0;
+  for (const auto &clip : clips)
+    activeChannels |= clip.channels;
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    if (activeChannels & (1u << i))
+      _activeSeconds[i] += elapsed;
+  }
+
+  Sample(clips);
+}
+
+void AnimationTelemetry::Sample(const std::vector<ClipTracker::Clip> &a_clips) {
+  ++_stamp;
+  for (const auto &clip : a_clips) {
+    auto [it, inserted] = _states.try_emplace(clip.generator);
+    auto &state = it->second;
+    state.stamp = _stamp;
+    if (inserted) {
+      // Non-interruptible clips only evaluate on activation, so a clip that
+      // went idle comes back here; restore what it played last time.
+      if (auto history = _history.find(clip.generator);
+          history != _history.end()) {
+        state.lastAnimation = std::move(history->second);
+        _history.erase(history);
+      }
+    }
+
+    const auto &info = clip.info;
+    std::string animation = info.animationPath.c_str();
+    if (!state.lastAnimation.empty() && animation != state.lastAnimation) {
+      for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+        if (clip.channels & (1u << i))
+          ++_switches[i];
+      }
+      ++_switchesBySubMod[std::format("{} / {}", info.modName.c_str(),
+                                      info.subModName.c_str())];
+    }
+    state.lastAnimation = std::move(animation);
+  }
+
+  // Clips the tracker dropped went idle
+  for (auto it = _states.begin(); it != _states.end();) {
+    if (it->second.stamp == _stamp) {
+      ++it;
+      continue;
+    }
+    if (_history.size() >= MAX_HISTORY)
+      _history.clear();
+    _history[it->first] = std::move(it->second.lastAnimation);
+    it = _states.erase(it);
+  }
+}
+
+bool AnimationTelemetry::WriteReport() {
+  auto path = SKSE::log::log_directory();
+  if (!path)
+    return false;
+
+  *path /= "RaySense_AnimationThrash.txt";
+  std::ofstream file(*path);
+  if (!file.is_open()) {
+    SKSE::log::error("AnimationTelemetry: Failed to open {}", path->string());
+    return false;
+  }
+
+  struct Row {
+    Channel channel;
+    std::uint64_t switches;
+    float activeSeconds;
+    double perMinute;
+  };
+  std::vector<Row> rows;
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    const float seconds = _activeSeconds[i];
+    rows.push_back({static_cast<Channel>(i), _switches[i], seconds,
+                    seconds > 0.0f ? _switches[i] * 60.0 / seconds : 0.0});
+  }
+  std::sort(rows.begin(), rows.end(), [](const Row &a_lhs, const Row &a_rhs) {
+    return a_lhs.perMinute > a_rhs.perMinute;
+  });
+
+  file << std::format("RaySense replacement thrash ({:.1f}s session)\n\n",
+                      _sessionTime);
+  file << std::format("{:<20} {:>10} {:>12} {:>12}\n", "Channel", "Switches",
+                      "Active(s)", "Switch/min");
+  for (const auto &row : rows) {
+    file << std::format("{:<20} {:>10} {:>12.1f} {:>12.2f}\n",
+                        GetChannelName(row.channel), row.switches,
+                        row.activeSeconds, row.perMinute);
+  }
+
+  std::vector<std::pair<std::string, std::uint64_t>> subMods(
+      _switchesBySubMod.begin(), _switchesBySubMod.end());
+  std::sort(subMods.begin(), subMods.end(),
+            [](const auto &a_lhs, const auto &a_rhs) {
+              return a_lhs.second > a_rhs.second;
+            });
+
+  file << std::format("\n{:>10}  {}\n", "Switches",
+                      "Switched to (mod / submod)");
+  for (const auto &[name, count] : subMods) {
+    file << std::format("{:>10}  {}\n", count, name);
+  }
+
+  SKSE::log::info("AnimationTelemetry: Wrote report to {}", path->string());
+  return true;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ClipTracker.h"
+#include "PCH.h"
+#include "SensorChannels.h"
+#include <array>
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Replacement thrash telemetry.
+// Periodically reads the clips ClipTracker saw evaluating RaySense
+// conditions for the player, with the replacement OAR plays on each, and
+// counts how often it changes, attributing every switch to the channels
+// that were part of that clip's decision.
+class AnimationTelemetry {
+public:
+  static AnimationTelemetry *GetSingleton() {
+    static AnimationTelemetry singleton;
+    return &singleton;
+  }
+
+  static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+  void Configure(bool a_enabled, float a_sampleInterval);
+
+  // Main thread, once per player update after ClipTracker::Update.
+  void Update(float a_delta);
+
+  bool WriteReport();
+
+private:
+  struct ClipState {
+    std::uint32_t stamp{0}; // Sample that last saw the clip
+    std::string lastAnimation;
+  };
+
+  AnimationTelemetry() = default;
+  ~AnimationTelemetry() = default;
+  AnimationTelemetry(const AnimationTelemetry &) = delete;
+  AnimationTelemetry(const AnimationTelemetry &&) = delete;
+  AnimationTelemetry &operator=(const AnimationTelemetry &) = delete;
+  AnimationTelemetry &operator=(const AnimationTelemetry &&) = delete;
+
+  void Sample(const std::vector<ClipTracker::Clip> &a_clips);
+
+  static inline std::atomic<bool> _enabled{false};
+  float _sampleInterval{0.1f};
+
+  static constexpr std::size_t MAX_HISTORY = 4096;
+
+  // Main thread only
+  std::unordered_map<RE::hkbClipGenerator *, ClipState> _states;
+  // Last replacement of clips that went idle. Only the strings are reused,
+  // the pointers are never passed back to OAR.
+  std::unordered_map<RE::hkbClipGenerator *, std::string> _history;
+  std::uint32_t _generation{0};
+  std::uint32_t _stamp{0};
+  float _sessionTime{0.0f};
+  float _sampleTimer{0.0f};
+  std::array<std::uint64_t, CHANNEL_COUNT> _switches{};
+  std::array<float, CHANNEL_COUNT> _activeSeconds{};
+  std::unordered_map<std::string, std::uint64_t> _switchesBySubMod;
+};
@@ -0,0 +1,117 @@
+#include "ClipSuppression.h"
+#include "ClipTracker.h"
+#include "Trace.h"
+#include <string_view>
+
+namespace {
+char Fold(char a_char) {
+  if (a_char == '/')
+    return '\\';
+  return a_char >= 'A' && a_char <= 'Z'
+             ? static_cast<char>(a_char - 'A' + 'a')
+             : a_char;
+}
+
+// Case-insensitive glob with * and ?; slashes match either way round
+bool Matches(std::string_view a_pattern, std::string_view a_text) {
+  if (a_pattern.empty())
+    return true;
+
+  std::size_t p = 0, t = 0;
+  std::size_t star = std::string_view::npos, resume = 0;
+  while (t < a_text.size()) {
+    if (p < a_pattern.size() &&
+        (a_pattern[p] == '?' || Fold(a_pattern[p]) == Fold(a_text[t]))) {
+      ++p;
+      ++t;
+    } else if (p < a_pattern.size() && a_pattern[p] == '*') {
+      star = p++;
+      resume = t;
+    } else if (star != std::string_view::npos) {
+      p = star + 1;
+      t = ++resume;
+    } else {
+      return false;
+    }
+  }
+  while (p < a_pattern.size() && a_pattern[p] == '*')
+    ++p;
+  return p == a_pattern.size();
+}
+} // namespace
+
+void ClipSuppression::Configure(
+    const std::vector<Settings::SuppressRule> &a_rules) {
+  _rules = a_rules;
+  _enabled.store(!_rules.empty(), std::memory_order_relaxed);
+
+  for (const auto &rule : _rules) {
+    SKSE::log::info("ClipSuppression: Rule '{}' (mod '{}', submod '{}', path "
+                    "'{}', {:.1f} Hz)",
+                    rule.name, rule.mod, rule.subMod, rule.path, rule.hz);
+  }
+}
+
+std::uint32_t ClipSuppression::Match(const char *a_mod, const char *a_subMod,
+                                     const char *a_path) const {
+  for (std::uint32_t i = 0; i < _rules.size(); ++i) {
+    const auto &rule = _rules[i];
+    if (Matches(rule.mod, a_mod) && Matches(rule.subMod, a_subMod) &&
+        Matches(rule.path, a_path))
+      return i;
+  }
+  return NO_RULE;
+}
+
+ChannelMask ClipSuppression::Update(float a_delta) {
+  if (!IsEnabled() || a_delta <= 0.0f)
+    return 0;
+
+  Trace::Scope scope("ClipSuppression");
+  auto *tracker = ClipTracker::GetSingleton();
+  const auto &clips = tracker->GetClips();
+  if (tracker->GetGeneration() != _generation) {
+    _generation = tracker->GetGeneration();
+    _states.clear();
+  }
+
+  // States of clips the tracker dropped go with them
+  ++_stamp;
+  ChannelMask held = 0;
+  for (const auto &clip : clips) {
+    auto &state = _states[clip.generator];
+    state.stamp = _stamp;
+
+    // OAR only reports a replacement while the clip is active
+    const auto &info = clip.info;
+    if (info.animationPath.empty()) {
+      state = {_stamp};
+      continue;
+    }
+
+    if (state.animation != info.animationPath.c_str()) {
+      state.animation = info.animationPath.c_str();
+      state.rule = Match(info.modName.c_str(), info.subModName.c_str(),
+                         info.animationPath.c_str());
+      state.elapsed = 0.0f;
+    }
+    if (state.rule == NO_RULE || clip.evaluated) {
+      state.elapsed = 0.0f;
+      continue;
+    }
+
+    const auto &rule = _rules[state.rule];
+    if (rule.hz > 0.0f) {
+      state.elapsed += a_delta;
+      if (state.elapsed >= 1.0f / rule.hz) {
+        state.elapsed = 0.0f;
+        continue;
+      }
+    }
+    held |= rule.channels;
+  }
+  std::erase_if(_states, [&](const auto &a_entry) {
+    return a_entry.second.stamp != _stamp;
+  });
+  return held;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "PCH.h"
+#include "SensorChannels.h"
+#include "Settings.h"
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Holds channels while the player plays a committed clip.
+// Reads the clips ClipTracker saw evaluating RaySense conditions and what
+// OAR plays on each; a replacement matching a [Suppress:<Name>] rule
+// freezes or throttles that rule's channels until the clip stops playing. A
+// clip evaluating again (it looped, or it is interruptible) gets one fresh
+// sample first.
+class ClipSuppression {
+public:
+  static ClipSuppression *GetSingleton() {
+    static ClipSuppression singleton;
+    return &singleton;
+  }
+
+  static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+  void Configure(const std::vector<Settings::SuppressRule> &a_rules);
+
+  // Main thread, once per player update after ClipTracker::Update. Returns
+  // the channels not to sample (or publish) this frame.
+  ChannelMask Update(float a_delta);
+
+private:
+  static constexpr std::uint32_t NO_RULE = UINT32_MAX;
+
+  struct ClipState {
+    std::uint32_t stamp{0}; // Update that last saw the clip
+    std::string animation;
+    std::uint32_t rule{NO_RULE};
+    float elapsed{0.0f}; // Since the last throttled sample
+  };
+
+  ClipSuppression() = default;
+  ~ClipSuppression() = default;
+  ClipSuppression(const ClipSuppression &) = delete;
+  ClipSuppression(const ClipSuppression &&) = delete;
+  ClipSuppression &operator=(const ClipSuppression &) = delete;
+  ClipSuppression &operator=(const ClipSuppression &&) = delete;
+
+  std::uint32_t Match(const char *a_mod, const char *a_subMod,
+                      const char *a_path) const;
+
+  static inline std::atomic<bool> _enabled{false};
+  std::vector<Settings::SuppressRule> _rules;
+
+  // Main thread only
+  std::unordered_map<RE::hkbClipGenerator *, ClipState> _states;
+  std::uint32_t _generation{0};
+  std::uint32_t _stamp{0};
+};
@@ -0,0 +1,87 @@
+#include "ClipTracker.h"
+#include "Trace.h"
+#include <utility>
+
+void ClipTracker::Configure(bool a_enabled) {
+  _enabled.store(a_enabled, std::memory_order_relaxed);
+}
+
+void ClipTracker::OnConditionEvaluated(RE::hkbClipGenerator *a_clipGenerator,
+                                       Channel a_channel) {
+  const float now = _sessionTime.load(std::memory_order_relaxed);
+
+  std::scoped_lock lock(_lock);
+  auto &clip = _clips[a_clipGenerator];
+  clip.channels |= ToMask(a_channel);
+  clip.lastSeen = now;
+  clip.evaluated = true;
+}
+
+void ClipTracker::Reset() {
+  {
+    std::scoped_lock lock(_lock);
+    _clips.clear();
+  }
+  _snapshot.clear();
+  _queried = true;
+  ++_generation;
+}
+
+void ClipTracker::Update(RE::PlayerCharacter *a_player, float a_delta) {
+  if (!IsEnabled() || a_delta <= 0.0f)
+    return;
+
+  // Tracked generators belong to the player's graph manager; a new one (3D
+  // reload) means the old ones may be freed
+  RE::BSTSmartPointer<RE::BSAnimationGraphManager> manager;
+  if (a_player)
+    a_player->GetAnimationGraphManager(manager);
+  if (manager.get() != _graph) {
+    _graph = manager.get();
+    Reset();
+  }
+
+  const float now = _sessionTime.load(std::memory_order_relaxed) + a_delta;
+  _sessionTime.store(now, std::memory_order_relaxed);
+
+  _snapshot.clear();
+  _queried = false;
+  std::scoped_lock lock(_lock);
+  for (auto it = _clips.begin(); it != _clips.end();) {
+    auto &[clipGenerator, clip] = *it;
+    if (!clip.playing && now - clip.lastSeen > STALE_CLIP_SECONDS) {
+      it = _clips.erase(it);
+      continue;
+    }
+    Clip &entry = _snapshot.emplace_back();
+    entry.generator = clipGenerator;
+    entry.channels = clip.channels;
+    entry.evaluated = std::exchange(clip.evaluated, false);
+    ++it;
+  }
+}
+
+const std::vector<ClipTracker::Clip> &ClipTracker::GetClips() {
+  if (_queried)
+    return _snapshot;
+  _queried = true;
+
+  auto *api = OAR_API::Animations::GetAPI();
+  if (!api) {
+    _snapshot.clear();
+    return _snapshot;
+  }
+
+  // OAR is queried without holding _lock: graph threads report clips from
+  // inside OAR's condition evaluation, while OAR holds its own locks
+  Trace::Scope scope("ClipTracker");
+  for (auto &clip : _snapshot)
+    clip.info = api->GetCurrentReplacementAnimationInfo(clip.generator);
+
+  std::scoped_lock lock(_lock);
+  for (const auto &clip : _snapshot) {
+    if (auto it = _clips.find(clip.generator); it != _clips.end())
+      it->second.playing = !clip.info.animationPath.empty();
+  }
+  return _snapshot;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "API/OpenAnimationReplacerAPI-Animations.h"
+#include "PCH.h"
+#include "SensorChannels.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Clip generators whose RaySense conditions the player's graph evaluates.
+// Graph threads report them during condition evaluation; once per player
+// update the main thread takes a snapshot, and the first consumer to ask
+// gets what OAR currently plays on each of them. AnimationTelemetry and
+// ClipSuppression both read this, so an evaluation costs one lock and one
+// map update however many features use it.
+class ClipTracker {
+public:
+  struct Clip {
+    RE::hkbClipGenerator *generator{nullptr};
+    ChannelMask channels{0}; // Every channel it has evaluated
+    bool evaluated{false};   // Since the previous update
+    OAR_API::Animations::ReplacementAnimationInfo info;
+  };
+
+  static ClipTracker *GetSingleton() {
+    static ClipTracker singleton;
+    return &singleton;
+  }
+
+  static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+  void Configure(bool a_enabled);
+
+  // Called from behavior graph threads during condition evaluation.
+  void OnConditionEvaluated(RE::hkbClipGenerator *a_clipGenerator,
+                            Channel a_channel);
+
+  // Main thread, once per player update, before any consumer reads clips.
+  void Update(RE::PlayerCharacter *a_player, float a_delta);
+
+  // Forgets all tracked clips; graphs are rebuilt when a save is loaded or
+  // sensing resumes after a cell change. Consumers see a new generation.
+  void Reset();
+
+  // Main thread. This update's clips with their current replacement; OAR
+  // is queried on the first call after Update only.
+  const std::vector<Clip> &GetClips();
+  // Changes whenever tracked clips were forgotten, so consumers drop state
+  // keyed by generator pointers that may since have been reused
+  [[nodiscard]] std::uint32_t GetGeneration() const { return _generation; }
+
+private:
+  // Clips that neither play nor evaluate are dropped after this long, so
+  // pointers from unloaded graphs are never handed back to OAR.
+  static constexpr float STALE_CLIP_SECONDS = 2.0f;
+
+  struct TrackedClip {
+    ChannelMask channels{0};
+    float lastSeen{0.0f}; // Session time of the last evaluation
+    bool evaluated{false}; // Since the last update
+    bool playing{false};   // OAR reported a replacement last time
+  };
+
+  ClipTracker() = default;
+  ~ClipTracker() = default;
+  ClipTracker(const ClipTracker &) = delete;
+  ClipTracker(const ClipTracker &&) = delete;
+  ClipTracker &operator=(const ClipTracker &) = delete;
+  ClipTracker &operator=(const ClipTracker &&) = delete;
+
+  static inline std::atomic<bool> _enabled{false};
+
+  std::mutex _lock; // Guards _clips
+  std::unordered_map<RE::hkbClipGenerator *, TrackedClip> _clips;
+  std::atomic<float> _sessionTime{0.0f};
+
+  // Main thread only
+  const RE::BSAnimationGraphManager *_graph{nullptr};
+  std::uint32_t _generation{0};
+  std::vector<Clip> _snapshot;
+  bool _queried{false};
+};
@@ -0,0 +1,101 @@
+#include "CollidableCache.h"
+
+void CollidableCache::Install(const std::vector<std::string> &a_keywords) {
+  _keywordCount = 0;
+  for (const auto &name : a_keywords) {
+    if (_keywordCount == MAX_KEYWORDS) {
+      SKSE::log::warn("CollidableCache: Only the first {} keywords are used",
+                      MAX_KEYWORDS);
+      break;
+    }
+    auto *keyword = RE::TESForm::LookupByEditorID<RE::BGSKeyword>(name);
+    if (!keyword)
+      SKSE::log::warn("CollidableCache: Keyword '{}' not found", name);
+    // Unresolved names keep their slot so bit i stays entry i
+    _keywords[_keywordCount++] = keyword;
+  }
+
+  if (auto *events = RE::ScriptEventSourceHolder::GetSingleton()) {
+    events->AddEventSink<RE::TESCellAttachDetachEvent>(this);
+    events->AddEventSink<RE::TESObjectLoadedEvent>(this);
+    SKSE::log::info("CollidableCache: Registered unload sinks ({} keywords)",
+                    _keywordCount);
+  }
+}
+
+CollidableCache::Info
+CollidableCache::Classify(const RE::hkpCollidable *a_collidable) {
+  if (!a_collidable)
+    return {};
+
+  const auto *shape = a_collidable->GetShape();
+  const auto layer = a_collidable->GetCollisionLayer();
+  {
+    std::shared_lock lock(_lock);
+    if (auto it = _entries.find(a_collidable);
+        it != _entries.end() && it->second.shape == shape &&
+        it->second.info.layer == layer)
+      return it->second.info;
+  }
+
+  const auto info = Resolve(a_collidable);
+
+  std::unique_lock lock(_lock);
+  if (_entries.size() >= CAPACITY)
+    _entries.clear();
+  _entries.insert_or_assign(a_collidable, Entry{info, shape});
+  return info;
+}
+
+CollidableCache::Info
+CollidableCache::Resolve(const RE::hkpCollidable *a_collidable) {
+  Info info;
+  info.layer = a_collidable->GetCollisionLayer();
+  if (auto *hkShape = a_collidable->GetShape()) {
+    if (auto *bhkShape = hkShape->userData)
+      info.material = bhkShape->materialID;
+  }
+
+  auto *ref = RE::TESHavokUtilities::FindCollidableRef(*a_collidable);
+  if (!ref)
+    return info;
+
+  info.ref = ref->GetFormID();
+  if (auto *base = ref->GetBaseObject())
+    info.formType = base->GetFormType();
+  info.isActor = ref->Is(RE::FormType::ActorCharacter);
+  for (std::size_t i = 0; i < _keywordCount; ++i) {
+    if (_keywords[i] && ref->HasKeyword(_keywords[i]))
+      info.keywords |= 1u << i;
+  }
+  return info;
+}
+
+void CollidableCache::Clear() {
+  std::unique_lock lock(_lock);
+  _entries.clear();
+}
+
+void CollidableCache::Evict(RE::FormID a_owner, bool a_unowned) {
+  std::unique_lock lock(_lock);
+  std::erase_if(_entries, [&](const auto &a_entry) {
+    const auto owner = a_entry.second.info.ref;
+    return owner == a_owner || (a_unowned && owner == 0);
+  });
+}
+
+RE::BSEventNotifyControl CollidableCache::ProcessEvent(
+    const RE::TESCellAttachDetachEvent *a_event,
+    RE::BSTEventSource<RE::TESCellAttachDetachEvent> *) {
+  if (a_event && a_event->reference && !a_event->attached)
+    Evict(a_event->reference->GetFormID(), true);
+  return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl CollidableCache::ProcessEvent(
+    const RE::TESObjectLoadedEvent *a_event,
+    RE::BSTEventSource<RE::TESObjectLoadedEvent> *) {
+  if (a_event && !a_event->loaded)
+    Evict(a_event->formID, false);
+  return RE::BSEventNotifyControl::kContinue;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "PCH.h"
+#include <array>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// What a ray hit, keyed by the collidable it returned.
+// The first hit on a collidable resolves its reference, base form, shape
+// material, layer and keywords; later hits are one map lookup. Entries are
+// dropped when their reference detaches or unloads, and ref-less entries
+// (terrain, bare statics) whenever any reference detaches, since their cell
+// may be going with it. A full cache is cleared wholesale.
+class CollidableCache
+    : public RE::BSTEventSink<RE::TESCellAttachDetachEvent>,
+      public RE::BSTEventSink<RE::TESObjectLoadedEvent> {
+public:
+  static CollidableCache *GetSingleton() {
+    static CollidableCache singleton;
+    return &singleton;
+  }
+
+  static constexpr std::size_t CAPACITY = 512;
+  static constexpr std::size_t MAX_KEYWORDS = 32;
+
+  struct Info {
+    RE::FormType formType{RE::FormType::kNone}; // Base object, kNone = no ref
+    RE::MATERIAL_ID material{RE::MATERIAL_ID::kNone}; // Shape material
+    RE::COL_LAYER layer{RE::COL_LAYER::kUnidentified};
+    std::uint32_t keywords{0}; // Bit i = [Classify] sKeywords entry i
+    RE::FormID ref{0}; // 0 = no reference
+    bool isActor{false};
+  };
+
+  // Resolves the keyword list and registers the event sinks (kDataLoaded)
+  void Install(const std::vector<std::string> &a_keywords);
+
+  // Any thread. a_collidable must come from a ray cast this frame.
+  Info Classify(const RE::hkpCollidable *a_collidable);
+  void Clear();
+
+  RE::BSEventNotifyControl ProcessEvent(
+      const RE::TESCellAttachDetachEvent *a_event,
+      RE::BSTEventSource<RE::TESCellAttachDetachEvent> *a_source) override;
+  RE::BSEventNotifyControl ProcessEvent(
+      const RE::TESObjectLoadedEvent *a_event,
+      RE::BSTEventSource<RE::TESObjectLoadedEvent> *a_source) override;
+
+private:
+  CollidableCache() = default;
+  ~CollidableCache() = default;
+  CollidableCache(const CollidableCache &) = delete;
+  CollidableCache(const CollidableCache &&) = delete;
+  CollidableCache &operator=(const CollidableCache &) = delete;
+  CollidableCache &operator=(const CollidableCache &&) = delete;
+
+  struct Entry {
+    Info info;
+    // A collidable freed and reallocated rarely keeps its shape and layer
+    const RE::hkpShape *shape{nullptr};
+  };
+
+  Info Resolve(const RE::hkpCollidable *a_collidable);
+  // Drops a_owner's entries, and every ref-less one when a_unowned is set
+  void Evict(RE::FormID a_owner, bool a_unowned);
+
+  std::array<RE::BGSKeyword *, MAX_KEYWORDS> _keywords{};
+  std::size_t _keywordCount{0};
+
+  mutable std::shared_mutex _lock;
+  std::unordered_map<const RE::hkpCollidable *, Entry> _entries;
+};
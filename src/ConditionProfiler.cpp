@@ -0,0 +1,115 @@
+#include "ConditionProfiler.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <map>
+#include <vector>
+
+void ConditionProfiler::Register(const Conditions::ICondition *a_condition,
+                                 const Counters *a_counters) {
+  Entry entry{a_condition->GetName().c_str(),
+              a_condition->GetArgument().c_str(), a_counters};
+
+  std::scoped_lock lock(_lock);
+  _instances.insert_or_assign(a_condition, std::move(entry));
+}
+
+void ConditionProfiler::Unregister(const Conditions::ICondition *a_condition) {
+  std::scoped_lock lock(_lock);
+  _instances.erase(a_condition);
+}
+
+bool ConditionProfiler::WriteReport() {
+  auto path = SKSE::log::log_directory();
+  if (!path)
+    return false;
+
+  struct Row {
+    std::string name;
+    std::string argument;
+    const void *subMod;
+    std::uint64_t evaluations;
+    std::uint64_t trueResults;
+    std::uint64_t totalNs;
+  };
+  std::vector<Row> rows;
+
+  {
+    // Holding the lock keeps every listed counter block alive.
+    std::scoped_lock lock(_lock);
+    rows.reserve(_instances.size());
+    for (const auto &[condition, entry] : _instances) {
+      const auto *counters = entry.counters;
+      rows.push_back({entry.name, entry.argument,
+                      counters->subMod.load(std::memory_order_relaxed),
+                      counters->evaluations.load(std::memory_order_relaxed),
+                      counters->trueResults.load(std::memory_order_relaxed),
+                      counters->totalNs.load(std::memory_order_relaxed)});
+    }
+  }
+
+  std::sort(rows.begin(), rows.end(), [](const Row &a_lhs, const Row &a_rhs) {
+    return a_lhs.totalNs > a_rhs.totalNs;
+  });
+
+  *path /= "RaySense_ConditionProfile.txt";
+  std::ofstream file(*path);
+  if (!file.is_open()) {
+    SKSE::log::error("ConditionProfiler: Failed to open {}", path->string());
+    return false;
+  }
+
+  std::uint64_t grandTotalNs = 0;
+  std::map<const void *, std::pair<std::uint64_t, std::uint64_t>> perSubMod;
+  for (const auto &row : rows) {
+    grandTotalNs += row.totalNs;
+    auto &[subModNs, subModEvals] = perSubMod[row.subMod];
+    subModNs += row.totalNs;
+    subModEvals += row.evaluations;
+  }
+
+  file << std::format("RaySense condition profile: {} instances, {:.3f} ms "
+                      "total evaluation time\n\n",
+                      rows.size(), grandTotalNs / 1'000'000.0);
+  file << std::format("{:>10} {:>10} {:>9} {:>7}  {:<18} {:<14} {}\n",
+                      "Total(ms)", "Evals", "Avg(ns)", "True%", "SubMod",
+                      "Flag", "Condition");
+
+  for (const auto &row : rows) {
+    const double truePct =
+        row.evaluations ? 100.0 * row.trueResults / row.evaluations : 0.0;
+    const char *flag = "";
+    if (row.evaluations == 0) {
+      flag = "NEVER_EVALUATED";
+    } else if (row.trueResults == row.evaluations) {
+      flag = "ALWAYS_TRUE";
+    } else if (row.trueResults == 0) {
+      flag = "ALWAYS_FALSE";
+    }
+
+    file << std::format(
+        "{:>10.3f} {:>10} {:>9} {:>6.1f}%  {:<18} {:<14} {} {}\n",
+        row.totalNs / 1'000'000.0, row.evaluations,
+        row.evaluations ? row.totalNs / row.evaluations : 0, truePct,
+        std::format("{}", row.subMod), flag, row.name, row.argument);
+  }
+
+  // Aggregate by owning submod so heavy submods stand out.
+  std::vector<std::pair<const void *, std::pair<std::uint64_t, std::uint64_t>>>
+      subMods(perSubMod.begin(), perSubMod.end());
+  std::sort(subMods.begin(), subMods.end(), [](const auto &a_lhs,
+                                               const auto &a_rhs) {
+    return a_lhs.second.first > a_rhs.second.first;
+  });
+
+  file << std::format("\n{:>10} {:>10}  {}\n", "Total(ms)", "Evals",
+                      "SubMod");
+  for (const auto &[subMod, totals] : subMods) {
+    file << std::format("{:>10.3f} {:>10}  {}\n", totals.first / 1'000'000.0,
+                        totals.second, subMod);
+  }
+
+  SKSE::log::info("ConditionProfiler: Wrote {} instances to {}", rows.size(),
+                  path->string());
+  return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "API/OpenAnimationReplacer-ConditionTypes.h"
+#include "PCH.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Optional per-instance evaluation statistics for RaySense OAR conditions.
+// Counters live inside each condition instance so the evaluation path never
+// touches shared state; the profiler only keeps the set of live instances
+// for reporting.
+class ConditionProfiler {
+public:
+  struct Counters {
+    std::atomic<std::uint64_t> evaluations{0};
+    std::atomic<std::uint64_t> trueResults{0};
+    std::atomic<std::uint64_t> totalNs{0};
+    std::atomic<void *> subMod{nullptr}; // Last evaluating submod
+  };
+
+  static ConditionProfiler *GetSingleton() {
+    static ConditionProfiler singleton;
+    return &singleton;
+  }
+
+  static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+  void SetEnabled(bool a_enabled) {
+    _enabled.store(a_enabled, std::memory_order_relaxed);
+  }
+
+  // Name and argument are captured here so reporting never has to call into
+  // an instance that may be under construction or destruction.
+  void Register(const Conditions::ICondition *a_condition,
+                const Counters *a_counters);
+  void Unregister(const Conditions::ICondition *a_condition);
+
+  // Writes all instances sorted by cumulative evaluation time.
+  bool WriteReport();
+
+private:
+  ConditionProfiler() = default;
+  ~ConditionProfiler() = default;
+  ConditionProfiler(const ConditionProfiler &) = delete;
+  ConditionProfiler(const ConditionProfiler &&) = delete;
+  ConditionProfiler &operator=(const ConditionProfiler &) = delete;
+  ConditionProfiler &operator=(const ConditionProfiler &&) = delete;
+
+  struct Entry {
+    std::string name;
+    std::string argument;
+    const Counters *counters;
+  };
+
+  static inline std::atomic<bool> _enabled{false};
+
+  std::mutex _lock;
+  std::unordered_map<const Conditions::ICondition *, Entry> _instances;
+};
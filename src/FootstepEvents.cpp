@@ -0,0 +1,42 @@
+#include "FootstepEvents.h"
+
+void FootstepEvents::Configure(bool a_enabled) {
+  _enabled.store(a_enabled, std::memory_order_relaxed);
+  if (a_enabled)
+    SKSE::log::info("FootstepEvents: Surface sampled on footfalls");
+}
+
+void FootstepEvents::Attach(RE::PlayerCharacter *a_player) {
+  RE::BSTSmartPointer<RE::BSAnimationGraphManager> manager;
+  if (!a_player || !a_player->GetAnimationGraphManager(manager) || !manager)
+    return;
+  if (manager.get() == _manager)
+    return;
+
+  _manager = manager.get();
+  a_player->RemoveAnimationGraphEventSink(this);
+  a_player->AddAnimationGraphEventSink(this);
+  // Whatever stood under the old graph is unknown
+  _pending.store(Foot::kBoth, std::memory_order_relaxed);
+  SKSE::log::info("FootstepEvents: Attached to player graph");
+}
+
+RE::BSEventNotifyControl
+FootstepEvents::ProcessEvent(const RE::BSAnimationGraphEvent *a_event,
+                             RE::BSTEventSource<RE::BSAnimationGraphEvent> *) {
+  if (!a_event)
+    return RE::BSEventNotifyControl::kContinue;
+
+  const std::string_view tag = a_event->tag;
+  Foot foot = Foot::kNone;
+  if (tag == "FootLeft"sv || tag == "FootSprintLeft"sv)
+    foot = Foot::kLeft;
+  else if (tag == "FootRight"sv || tag == "FootSprintRight"sv)
+    foot = Foot::kRight;
+  else if (tag == "JumpUp"sv || tag == "JumpDown"sv)
+    foot = Foot::kBoth;
+
+  if (foot != Foot::kNone)
+    _pending.store(foot, std::memory_order_relaxed);
+  return RE::BSEventNotifyControl::kContinue;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "PCH.h"
+#include <atomic>
+
+// Footfall and jump annotations from the player's animation graph.
+// The surface under the player only matters when a foot comes down, so the
+// surface pass waits for one of these instead of running every tick. Graph
+// events may arrive on animation worker threads; the sink only records which
+// foot landed and the main thread samples on its next update.
+class FootstepEvents : public RE::BSTEventSink<RE::BSAnimationGraphEvent> {
+public:
+  static FootstepEvents *GetSingleton() {
+    static FootstepEvents singleton;
+    return &singleton;
+  }
+
+  enum class Foot : std::uint32_t { kNone = 0, kLeft, kRight, kBoth };
+
+  void Configure(bool a_enabled);
+  static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+  // Re-registers when the player's graph manager was rebuilt (main thread)
+  void Attach(RE::PlayerCharacter *a_player);
+  // The footfall since the last call, kNone if there was none
+  Foot Consume() {
+    return _pending.exchange(Foot::kNone, std::memory_order_relaxed);
+  }
+
+  RE::BSEventNotifyControl ProcessEvent(
+      const RE::BSAnimationGraphEvent *a_event,
+      RE::BSTEventSource<RE::BSAnimationGraphEvent> *a_source) override;
+
+private:
+  FootstepEvents() = default;
+  ~FootstepEvents() = default;
+  FootstepEvents(const FootstepEvents &) = delete;
+  FootstepEvents(const FootstepEvents &&) = delete;
+  FootstepEvents &operator=(const FootstepEvents &) = delete;
+  FootstepEvents &operator=(const FootstepEvents &&) = delete;
+
+  static inline std::atomic<bool> _enabled{false};
+  std::atomic<Foot> _pending{Foot::kNone};
+  const void *_manager{nullptr}; // Compared, never dereferenced
+};
@@ -1,6 +1,16 @@
 #include "Hooks.h"
+#include "ActorSensorCache.h"
+#include "AnimationTelemetry.h"
+#include "ClipTracker.h"
+#include "CollidableCache.h"
 #include "PCH.h"
 #include "RaySenseLogic.h"
+#include "SenseLatency.h"
+#include "SensingGate.h"
+#include "Settings.h"
+#include "SpatialProfiler.h"
+#include "Trace.h"
+#include "WaterCache.h"
 
 namespace Hooks {
 void PlayerHook::Install() {
@@ -12,17 +22,67 @@ void PlayerHook::Install() {
   // Jump Hook (0x14)
   _Jump = vtable.write_vfunc(0x14, reinterpret_cast<std::uintptr_t>(Jump));
 
+  _senseFirst = Settings::GetSingleton()->sampleFirst;
+
   SKSE::log::info(
-      "PlayerHook: Hooks installed at 0xAD (Update) and 0x14 (Jump)");
+      "PlayerHook: Hooks installed at 0xAD (Update) and 0x14 (Jump), sensing "
+      "{} the original update",
+      _senseFirst ? "before" : "after");
 }
 
 void PlayerHook::Update(RE::PlayerCharacter *a_this, float a_delta) {
-  // Call original first
+  if (SenseLatency::IsEnabled())
+    SenseLatency::GetSingleton()->BeginFrame();
+
+  // [Sample First]
+  // The original update also advances the behavior graph, so conditions see
+  // values sensed before it in the same frame; sensing then works from the
+  // position predicted for the end of this update.
   using func_t = void (*)(RE::PlayerCharacter *, float);
-  reinterpret_cast<func_t>(_Update)(a_this, a_delta);
+  if (_senseFirst) {
+    Sense(a_this, a_delta);
+    reinterpret_cast<func_t>(_Update)(a_this, a_delta);
+  } else {
+    reinterpret_cast<func_t>(_Update)(a_this, a_delta);
+    Sense(a_this, a_delta);
+  }
+}
+
+void PlayerHook::Sense(RE::PlayerCharacter *a_this, float a_delta) {
+  // Nothing to sense while paused, loading or between cells
+  auto *gate = SensingGate::GetSingleton();
+  if (gate->IsSuspended())
+    return;
+  if (gate->ConsumeTransition()) {
+    RaySenseLogic::GetSingleton()->Reset();
+    ActorSensorCache::GetSingleton()->Reset();
+    CollidableCache::GetSingleton()->Clear();
+    WaterCache::GetSingleton()->ClearPlanes();
+    // Clip generators from before the transition may belong to freed graphs
+    ClipTracker::GetSingleton()->Reset();
+  }
+
+  if (ClipTracker::IsEnabled())
+    ClipTracker::GetSingleton()->Update(a_this, a_delta);
 
   // Run our logic
-  RaySenseLogic::GetSingleton()->OnUpdate(a_this, a_delta);
+  const bool spatialEnabled = SpatialProfiler::IsEnabled();
+  const auto start =
+      (Trace::IsEnabled() || spatialEnabled) ? Trace::Now() : 0;
+  {
+    Trace::Scope scope("OnUpdate");
+    RaySenseLogic::GetSingleton()->OnUpdate(a_this, a_delta);
+    ActorSensorCache::GetSingleton()->Update(a_delta);
+  }
+  if (start) {
+    const auto end = Trace::Now();
+    Trace::GetSingleton()->OnFrameEnd(start, end);
+    if (spatialEnabled)
+      SpatialProfiler::GetSingleton()->OnFrameEnd(a_this, end - start);
+  }
+
+  if (AnimationTelemetry::IsEnabled())
+    AnimationTelemetry::GetSingleton()->Update(a_delta);
 }
 
 void PlayerHook::Jump(RE::PlayerCharacter *a_this) {
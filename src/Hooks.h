@@ -10,7 +10,10 @@ public:
 private:
   static void Update(RE::PlayerCharacter *a_this, float a_delta);
   static void Jump(RE::PlayerCharacter *a_this);
+  // Gate, sensing and per-frame bookkeeping around the original update
+  static void Sense(RE::PlayerCharacter *a_this, float a_delta);
 
+  static inline bool _senseFirst{false};
   static inline std::uintptr_t _Update;
   static inline std::uintptr_t _Jump;
 };
@@ -0,0 +1,59 @@
+#include "InputHandler.h"
+#include "AnimationTelemetry.h"
+#include "ConditionProfiler.h"
+#include "RaySenseLogic.h"
+#include "SenseLatency.h"
+#include "SensorProfiles.h"
+#include "Settings.h"
+#include "SpatialProfiler.h"
+#include "Trace.h"
+
+void InputHandler::Install() {
+  if (auto *inputManager = RE::BSInputDeviceManager::GetSingleton()) {
+    inputManager->AddEventSink(this);
+    SKSE::log::info("InputHandler: Registered input event sink");
+  }
+}
+
+RE::BSEventNotifyControl
+InputHandler::ProcessEvent(RE::InputEvent *const *a_event,
+                           RE::BSTEventSource<RE::InputEvent *> *) {
+  if (!a_event)
+    return RE::BSEventNotifyControl::kContinue;
+
+  const auto *settings = Settings::GetSingleton();
+
+  for (auto *event = *a_event; event; event = event->next) {
+    if (event->GetDevice() != RE::INPUT_DEVICE::kKeyboard)
+      continue;
+
+    auto *button = event->AsButtonEvent();
+    if (!button || !button->IsDown())
+      continue;
+
+    const auto key = button->GetIDCode();
+    if (key == 0)
+      continue;
+
+    if (key == settings->traceDumpHotkey && Trace::IsEnabled()) {
+      Trace::GetSingleton()->Dump(settings->traceDumpSeconds);
+    }
+
+    if (key == settings->reportHotkey) {
+      if (ConditionProfiler::IsEnabled())
+        ConditionProfiler::GetSingleton()->WriteReport();
+      if (AnimationTelemetry::IsEnabled())
+        AnimationTelemetry::GetSingleton()->WriteReport();
+      if (SpatialProfiler::IsEnabled())
+        SpatialProfiler::GetSingleton()->WriteReport();
+      if (SenseLatency::IsEnabled())
+        SenseLatency::GetSingleton()->WriteReport();
+      if (RaySenseLogic::GetSingleton()->GetGovernor().HasBudget())
+        RaySenseLogic::GetSingleton()->GetGovernor().WriteReport();
+      SensorProfiles::GetSingleton()->WriteReport();
+      RaySenseLogic::GetSingleton()->GetLandMaterials().WriteReport();
+    }
+  }
+
+  return RE::BSEventNotifyControl::kContinue;
+}
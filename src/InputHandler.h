@@ -0,0 +1,26 @@
+#pragma once
+
+#include "PCH.h"
+
+// Dispatches the diagnostic hotkeys configured in Settings.
+class InputHandler : public RE::BSTEventSink<RE::InputEvent *> {
+public:
+  static InputHandler *GetSingleton() {
+    static InputHandler singleton;
+    return &singleton;
+  }
+
+  void Install();
+
+  RE::BSEventNotifyControl
+  ProcessEvent(RE::InputEvent *const *a_event,
+               RE::BSTEventSource<RE::InputEvent *> *a_source) override;
+
+private:
+  InputHandler() = default;
+  ~InputHandler() = default;
+  InputHandler(const InputHandler &) = delete;
+  InputHandler(const InputHandler &&) = delete;
+  InputHandler &operator=(const InputHandler &) = delete;
+  InputHandler &operator=(const InputHandler &&) = delete;
+};
@@ -0,0 +1,104 @@
+#include "LandMaterialCache.h"
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <limits>
+
+const LandMaterialCache::Entry &
+LandMaterialCache::Lookup(const RE::NiPoint3 &a_pos) {
+  const auto x = static_cast<std::int32_t>(std::floor(a_pos.x / TEXEL_SIZE));
+  const auto y = static_cast<std::int32_t>(std::floor(a_pos.y / TEXEL_SIZE));
+  const auto key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x))
+                    << 32) |
+                   static_cast<std::uint32_t>(y);
+
+  if (auto it = _entries.find(key); it != _entries.end()) {
+    ++_hits;
+    return it->second;
+  }
+
+  auto *tes = RE::TES::GetSingleton();
+  if (!tes)
+    return _none;
+
+  ++_misses;
+  if (_entries.size() >= CAPACITY)
+    Clear();
+  return _entries.emplace(key, Sample(tes, x, y, a_pos)).first->second;
+}
+
+LandMaterialCache::Entry LandMaterialCache::Sample(RE::TES *a_tes,
+                                                   std::int32_t a_x,
+                                                   std::int32_t a_y,
+                                                   const RE::NiPoint3 &a_pos) {
+  // Just inside each corner so a shared vertex reads from this texture cell
+  constexpr float INSET = 1.0f;
+  const float minX = a_x * TEXEL_SIZE + INSET;
+  const float minY = a_y * TEXEL_SIZE + INSET;
+  const float maxX = (a_x + 1) * TEXEL_SIZE - INSET;
+  const float maxY = (a_y + 1) * TEXEL_SIZE - INSET;
+  const RE::NiPoint3 corners[CORNERS] = {{minX, minY, a_pos.z},
+                                         {maxX, minY, a_pos.z},
+                                         {minX, maxY, a_pos.z},
+                                         {maxX, maxY, a_pos.z}};
+
+  Entry entry;
+  std::uint32_t nearest = 0;
+  float nearestDist = std::numeric_limits<float>::max();
+  std::array<std::uint32_t, CORNERS> slotOf{};
+  for (std::uint32_t i = 0; i < CORNERS; ++i) {
+    const auto material = a_tes->GetLandMaterialType(corners[i]);
+    std::uint32_t slot = 0;
+    while (slot < entry.count && entry.materials[slot] != material)
+      ++slot;
+    if (slot == entry.count)
+      entry.materials[entry.count++] = material;
+    entry.weights[slot] += 1.0f / CORNERS;
+    slotOf[i] = slot;
+
+    const float dist = corners[i].GetDistance(a_pos);
+    if (dist < nearestDist) {
+      nearestDist = dist;
+      nearest = i;
+    }
+  }
+
+  // Heaviest material wins; a tie goes to the corner nearest the query
+  std::uint32_t best = slotOf[nearest];
+  for (std::uint32_t slot = 0; slot < entry.count; ++slot) {
+    if (entry.weights[slot] > entry.weights[best])
+      best = slot;
+  }
+  entry.dominant = entry.materials[best];
+  return entry;
+}
+
+void LandMaterialCache::Clear() {
+  if (!_entries.empty())
+    ++_clears;
+  _entries.clear();
+}
+
+void LandMaterialCache::WriteReport() const {
+  auto path = SKSE::log::log_directory();
+  if (!path)
+    return;
+
+  *path /= "RaySense_LandMaterial.txt";
+  std::ofstream file(*path);
+  if (!file.is_open()) {
+    SKSE::log::error("LandMaterialCache: Failed to open {}", path->string());
+    return;
+  }
+
+  const auto lookups = _hits + _misses;
+  file << std::format("Lookups: {}\n", lookups);
+  file << std::format("Hits: {} ({:.2f}%)\n", _hits,
+                      lookups ? 100.0 * _hits / lookups : 0.0);
+  file << std::format("Misses: {} ({} land material queries)\n", _misses,
+                      _misses * CORNERS);
+  file << std::format("Clears: {}\n", _clears);
+  file << std::format("Cached texture cells: {}\n", _entries.size());
+
+  SKSE::log::info("LandMaterialCache: Wrote {}", path->string());
+}
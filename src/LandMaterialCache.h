@@ -0,0 +1,45 @@
+#pragma once
+
+#include "PCH.h"
+#include <array>
+#include <unordered_map>
+
+// Landscape material per texture cell.
+// Land textures are painted per vertex, 32 vertices to a cell edge, so the
+// material under a point only changes when it crosses into another 128 unit
+// texture cell. The first lookup in a texture cell samples its four corners
+// once; every later point inside it reuses the result. The cache is
+// worldspace-relative and is cleared whenever the player changes cell, as
+// the loaded land moves with it. Main thread only.
+class LandMaterialCache {
+public:
+  static constexpr float TEXEL_SIZE = 128.0f; // 4096 unit cell / 32
+  static constexpr std::size_t CAPACITY = 256;
+  static constexpr std::size_t CORNERS = 4;
+
+  struct Entry {
+    RE::MATERIAL_ID dominant{RE::MATERIAL_ID::kNone};
+    // Distinct corner materials and their share, count entries used
+    std::array<RE::MATERIAL_ID, CORNERS> materials{};
+    std::array<float, CORNERS> weights{};
+    std::uint32_t count{0};
+  };
+
+  const Entry &Lookup(const RE::NiPoint3 &a_pos);
+  void Clear();
+
+  // Writes RaySense_LandMaterial.txt to the SKSE log folder
+  void WriteReport() const;
+
+private:
+  static Entry Sample(RE::TES *a_tes, std::int32_t a_x, std::int32_t a_y,
+                      const RE::NiPoint3 &a_pos);
+
+  std::unordered_map<std::uint64_t, Entry> _entries;
+  Entry _none; // Returned without a TES
+
+  // Metrics
+  std::uint64_t _hits{0};
+  std::uint64_t _misses{0};
+  std::uint64_t _clears{0};
+};
@@ -1,14 +1,72 @@
 #include "OARConditions.h"
+#include "ClipTracker.h"
+#include "SenseLatency.h"
 #include <cmath>
 #include <format>
 
 namespace OARConditions {
+// --- RaySenseCondition ---
+
+RaySenseCondition::~RaySenseCondition() {
+  if (_profileRegistered.load(std::memory_order_relaxed))
+    ConditionProfiler::GetSingleton()->Unregister(this);
+}
+
+void RaySenseCondition::PostInitialize() {
+  CustomCondition::PostInitialize();
+  if (ConditionProfiler::IsEnabled())
+    RegisterProfile();
+}
+
+void RaySenseCondition::RegisterProfile() const {
+  if (!_profileRegistered.exchange(true, std::memory_order_relaxed))
+    ConditionProfiler::GetSingleton()->Register(this, &_profile);
+}
+
+bool RaySenseCondition::Evaluate(RE::TESObjectREFR *a_refr,
+                                 RE::hkbClipGenerator *a_clipGenerator,
+                                 void *a_parentSubMod) const {
+  if (a_refr && a_refr->IsPlayerRef()) {
+    if (SenseLatency::IsEnabled())
+      SenseLatency::GetSingleton()->OnConsume(GetChannel());
+    if (ClipTracker::IsEnabled() && a_clipGenerator)
+      ClipTracker::GetSingleton()->OnConditionEvaluated(a_clipGenerator,
+                                                        GetChannel());
+  }
+
+  if (!ConditionProfiler::IsEnabled())
+    return CustomCondition::Evaluate(a_refr, a_clipGenerator, a_parentSubMod);
+
+  RegisterProfile();
+
+  const auto start = std::chrono::steady_clock::now();
+  const bool result =
+      CustomCondition::Evaluate(a_refr, a_clipGenerator, a_parentSubMod);
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  _profile.evaluations.fetch_add(1, std::memory_order_relaxed);
+  if (result)
+    _profile.trueResults.fetch_add(1, std::memory_order_relaxed);
+  _profile.totalNs.fetch_add(static_cast<std::uint64_t>(elapsed.count()),
+                             std::memory_order_relaxed);
+  _profile.subMod.store(a_parentSubMod, std::memory_order_relaxed);
+  return result;
+}
+
+bool RaySenseCondition::ReadChannel(RE::TESObjectREFR *a_refr,
+                                    float &a_value) const {
+  return RaySenseLogic::GetSingleton()->GetChannelValue(a_refr, GetChannel(),
+                                                        a_value);
+}
+
 // --- VerticalityCondition ---
 
 VerticalityCondition::VerticalityCondition() {
   sensorIndexComponent = static_cast<Conditions::INumericConditionComponent *>(
       AddBaseComponent(Conditions::ConditionComponentType::kNumeric,
-                       "Sensor(0:F, 1:L, 2:R, 3:P, 4:S, 5:Pl)"));
+                       "Sensor(0:F, 1:L, 2:R, 3:P, 4:S, 5:Pl, 6:WD, 7:WA, "
+                       "8:Sh, 9:LT, 10:LH, 11:LS, 12:FR, 13:WR, 14:AN)"));
   comparisonComponent =
       static_cast<Conditions::IComparisonConditionComponent *>(AddBaseComponent(
           Conditions::ConditionComponentType::kComparison, "Comparison"));
@@ -38,6 +96,33 @@ RE::BSString VerticalityCondition::GetArgument() const {
   case 5:
     sensorName = "Platform";
     break;
+  case 6:
+    sensorName = "WaterDepth";
+    break;
+  case 7:
+    sensorName = "WaterAhead";
+    break;
+  case 8:
+    sensorName = "Shore";
+    break;
+  case 9:
+    sensorName = "LandingTime";
+    break;
+  case 10:
+    sensorName = "LandingHeight";
+    break;
+  case 11:
+    sensorName = "LandingSurface";
+    break;
+  case 12:
+    sensorName = "FrontRoughness";
+    break;
+  case 13:
+    sensorName = "WallRoughness";
+    break;
+  case 14:
+    sensorName = "ArrayNearest";
+    break;
   }
 
   return RE::BSString(std::format("{} {} {}", sensorName,
@@ -46,71 +131,42 @@ RE::BSString VerticalityCondition::GetArgument() const {
                           .c_str());
 }
 
-RE::BSString VerticalityCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
-    return "0";
+bool VerticalityCondition::ReadSensor(RE::TESObjectREFR *a_refr, int a_index,
+                                      float &a_value) {
+  if (!a_refr)
+    return false;
+  // Unknown sensor indices have always read as 0
+  if (a_index < 0 || a_index >= SENSOR_COUNT) {
+    a_value = 0.0f;
+    return true;
+  }
+  return RaySenseLogic::GetSingleton()->GetChannelValue(
+      a_refr, GetVerticalityChannel(a_index), a_value);
+}
 
-  auto *logic = RaySenseLogic::GetSingleton();
+Channel VerticalityCondition::GetChannel() const {
+  float fIdx = sensorIndexComponent->GetNumericValue(nullptr);
+  return GetVerticalityChannel(std::isfinite(fIdx) ? static_cast<int>(fIdx)
+                                                   : 0);
+}
+
+RE::BSString VerticalityCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
   float fIdx = sensorIndexComponent->GetNumericValue(a_refr);
   if (!std::isfinite(fIdx))
     return "0";
 
-  int idx = static_cast<int>(fIdx);
   float val = 0.0f;
-  switch (idx) {
-  case 0:
-    val = logic->GetFrontDiff();
-    break;
-  case 1:
-    val = logic->GetLeftDiff();
-    break;
-  case 2:
-    val = logic->GetRightDiff();
-    break;
-  case 3:
-    val = logic->GetPlayerHeight();
-    break;
-  case 4:
-    val = logic->GetSurfaceType();
-    break;
-  case 5:
-    val = logic->GetPlatformType();
-    break;
-  }
-
-  if (!std::isfinite(val))
+  if (!ReadSensor(a_refr, static_cast<int>(fIdx), val) || !std::isfinite(val))
     return "0";
   return RE::BSString(std::to_string(static_cast<int>(val)).c_str());
 }
 
 bool VerticalityCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                         RE::hkbClipGenerator *, void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
-    return false;
-
-  auto *logic = RaySenseLogic::GetSingleton();
   int idx = static_cast<int>(sensorIndexComponent->GetNumericValue(a_refr));
   float currentVal = 0.0f;
-  switch (idx) {
-  case 0:
-    currentVal = logic->GetFrontDiff();
-    break;
-  case 1:
-    currentVal = logic->GetLeftDiff();
-    break;
-  case 2:
-    currentVal = logic->GetRightDiff();
-    break;
-  case 3:
-    currentVal = logic->GetPlayerHeight();
-    break;
-  case 4:
-    currentVal = logic->GetSurfaceType();
-    break;
-  case 5:
-    currentVal = logic->GetPlatformType();
-    break;
-  }
+  if (!ReadSensor(a_refr, idx, currentVal))
+    return false;
 
   return comparisonComponent->GetComparisonResult(
       currentVal, valueComponent->GetNumericValue(a_refr));
@@ -132,18 +188,16 @@ RE::BSString ObstacleCondition::GetArgument() const {
                           .c_str());
 }
 RE::BSString ObstacleCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
-    return "0";
-  float dist = RaySenseLogic::GetSingleton()->GetObstacleDist();
-  if (!std::isfinite(dist))
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist) || !std::isfinite(dist))
     return "0";
   return RE::BSString(std::to_string(static_cast<int>(dist)).c_str());
 }
 bool ObstacleCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                      RE::hkbClipGenerator *, void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist))
     return false;
-  float dist = RaySenseLogic::GetSingleton()->GetObstacleDist();
   return comparisonComponent->GetComparisonResult(
       dist, valueComponent->GetNumericValue(a_refr));
 }
@@ -164,18 +218,16 @@ RE::BSString WallFrontCondition::GetArgument() const {
                           .c_str());
 }
 RE::BSString WallFrontCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
-    return "0";
-  float dist = RaySenseLogic::GetSingleton()->GetWallFrontDist();
-  if (!std::isfinite(dist))
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist) || !std::isfinite(dist))
     return "0";
   return RE::BSString(std::to_string(static_cast<int>(dist)).c_str());
 }
 bool WallFrontCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                       RE::hkbClipGenerator *, void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist))
     return false;
-  float dist = RaySenseLogic::GetSingleton()->GetWallFrontDist();
   return comparisonComponent->GetComparisonResult(
       dist, valueComponent->GetNumericValue(a_refr));
 }
@@ -196,18 +248,16 @@ RE::BSString WallFrontLCondition::GetArgument() const {
                           .c_str());
 }
 RE::BSString WallFrontLCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
-    return "0";
-  float dist = RaySenseLogic::GetSingleton()->GetWallFrontLDist();
-  if (!std::isfinite(dist))
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist) || !std::isfinite(dist))
     return "0";
   return RE::BSString(std::to_string(static_cast<int>(dist)).c_str());
 }
 bool WallFrontLCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                        RE::hkbClipGenerator *, void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist))
     return false;
-  float dist = RaySenseLogic::GetSingleton()->GetWallFrontLDist();
   return comparisonComponent->GetComparisonResult(
       dist, valueComponent->GetNumericValue(a_refr));
 }
@@ -228,18 +278,16 @@ RE::BSString WallFrontRCondition::GetArgument() const {
                           .c_str());
 }
 RE::BSString WallFrontRCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
-    return "0";
-  float dist = RaySenseLogic::GetSingleton()->GetWallFrontRDist();
-  if (!std::isfinite(dist))
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist) || !std::isfinite(dist))
     return "0";
   return RE::BSString(std::to_string(static_cast<int>(dist)).c_str());
 }
 bool WallFrontRCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                        RE::hkbClipGenerator *, void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist))
     return false;
-  float dist = RaySenseLogic::GetSingleton()->GetWallFrontRDist();
   return comparisonComponent->GetComparisonResult(
       dist, valueComponent->GetNumericValue(a_refr));
 }
@@ -260,18 +308,16 @@ RE::BSString WallLeftCondition::GetArgument() const {
                           .c_str());
 }
 RE::BSString WallLeftCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
-    return "0";
-  float dist = RaySenseLogic::GetSingleton()->GetWallLeftDist();
-  if (!std::isfinite(dist))
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist) || !std::isfinite(dist))
     return "0";
   return RE::BSString(std::to_string(static_cast<int>(dist)).c_str());
 }
 bool WallLeftCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                      RE::hkbClipGenerator *, void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist))
     return false;
-  float dist = RaySenseLogic::GetSingleton()->GetWallLeftDist();
   return comparisonComponent->GetComparisonResult(
       dist, valueComponent->GetNumericValue(a_refr));
 }
@@ -292,18 +338,16 @@ RE::BSString WallRightCondition::GetArgument() const {
                           .c_str());
 }
 RE::BSString WallRightCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
-    return "0";
-  float dist = RaySenseLogic::GetSingleton()->GetWallRightDist();
-  if (!std::isfinite(dist))
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist) || !std::isfinite(dist))
     return "0";
   return RE::BSString(std::to_string(static_cast<int>(dist)).c_str());
 }
 bool WallRightCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                       RE::hkbClipGenerator *, void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float dist = 0.0f;
+  if (!ReadChannel(a_refr, dist))
     return false;
-  float dist = RaySenseLogic::GetSingleton()->GetWallRightDist();
   return comparisonComponent->GetComparisonResult(
       dist, valueComponent->GetNumericValue(a_refr));
 }
@@ -325,19 +369,19 @@ RE::BSString ObstacleTypeFrontCondition::GetArgument() const {
 }
 RE::BSString
 ObstacleTypeFrontCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float type = 0.0f;
+  if (!ReadChannel(a_refr, type))
     return "0";
-  std::uint32_t type = RaySenseLogic::GetSingleton()->GetObstacleTypeFront();
   return RE::BSString(std::to_string(static_cast<int>(type)).c_str());
 }
 bool ObstacleTypeFrontCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                               RE::hkbClipGenerator *,
                                               void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float type = 0.0f;
+  if (!ReadChannel(a_refr, type))
     return false;
   return comparisonComponent->GetComparisonResult(
-      static_cast<float>(RaySenseLogic::GetSingleton()->GetObstacleTypeFront()),
-      valueComponent->GetNumericValue(a_refr));
+      type, valueComponent->GetNumericValue(a_refr));
 }
 
 // --- ObstacleTypeLeftCondition ---
@@ -357,19 +401,19 @@ RE::BSString ObstacleTypeLeftCondition::GetArgument() const {
 }
 RE::BSString
 ObstacleTypeLeftCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float type = 0.0f;
+  if (!ReadChannel(a_refr, type))
     return "0";
-  std::uint32_t type = RaySenseLogic::GetSingleton()->GetObstacleTypeLeft();
   return RE::BSString(std::to_string(static_cast<int>(type)).c_str());
 }
 bool ObstacleTypeLeftCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                              RE::hkbClipGenerator *,
                                              void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float type = 0.0f;
+  if (!ReadChannel(a_refr, type))
     return false;
   return comparisonComponent->GetComparisonResult(
-      static_cast<float>(RaySenseLogic::GetSingleton()->GetObstacleTypeLeft()),
-      valueComponent->GetNumericValue(a_refr));
+      type, valueComponent->GetNumericValue(a_refr));
 }
 
 // --- ObstacleTypeRightCondition ---
@@ -389,18 +433,68 @@ RE::BSString ObstacleTypeRightCondition::GetArgument() const {
 }
 RE::BSString
 ObstacleTypeRightCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float type = 0.0f;
+  if (!ReadChannel(a_refr, type))
     return "0";
-  std::uint32_t type = RaySenseLogic::GetSingleton()->GetObstacleTypeRight();
   return RE::BSString(std::to_string(static_cast<int>(type)).c_str());
 }
 bool ObstacleTypeRightCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
                                               RE::hkbClipGenerator *,
                                               void *) const {
-  if (!a_refr || !a_refr->IsPlayerRef())
+  float type = 0.0f;
+  if (!ReadChannel(a_refr, type))
     return false;
   return comparisonComponent->GetComparisonResult(
-      static_cast<float>(RaySenseLogic::GetSingleton()->GetObstacleTypeRight()),
-      valueComponent->GetNumericValue(a_refr));
+      type, valueComponent->GetNumericValue(a_refr));
+}
+
+// --- ArrayCondition ---
+ArrayCondition::ArrayCondition() {
+  directionComponent =
+      static_cast<Conditions::INumericConditionComponent *>(AddBaseComponent(
+          Conditions::ConditionComponentType::kNumeric,
+          "Direction (0 = ahead, clockwise)"));
+  heightComponent =
+      static_cast<Conditions::INumericConditionComponent *>(AddBaseComponent(
+          Conditions::ConditionComponentType::kNumeric, "Height (ring)"));
+  comparisonComponent =
+      static_cast<Conditions::IComparisonConditionComponent *>(AddBaseComponent(
+          Conditions::ConditionComponentType::kComparison, "Comparison"));
+  valueComponent =
+      static_cast<Conditions::INumericConditionComponent *>(AddBaseComponent(
+          Conditions::ConditionComponentType::kNumeric, "Distance"));
+}
+bool ArrayCondition::ReadElement(RE::TESObjectREFR *a_refr,
+                                 float &a_value) const {
+  const float direction = directionComponent->GetNumericValue(a_refr);
+  const float height = heightComponent->GetNumericValue(a_refr);
+  if (!std::isfinite(direction) || !std::isfinite(height) ||
+      direction < 0.0f || height < 0.0f)
+    return false;
+  return RaySenseLogic::GetSingleton()->GetArrayValue(
+      a_refr, static_cast<std::uint32_t>(direction),
+      static_cast<std::uint32_t>(height), a_value);
+}
+RE::BSString ArrayCondition::GetArgument() const {
+  return RE::BSString(std::format("Array {} {} {} {}",
+                                  directionComponent->GetArgument().c_str(),
+                                  heightComponent->GetArgument().c_str(),
+                                  comparisonComponent->GetArgument().c_str(),
+                                  valueComponent->GetArgument().c_str())
+                          .c_str());
+}
+RE::BSString ArrayCondition::GetCurrent(RE::TESObjectREFR *a_refr) const {
+  float dist = 0.0f;
+  if (!ReadElement(a_refr, dist) || !std::isfinite(dist))
+    return "0";
+  return RE::BSString(std::to_string(static_cast<int>(dist)).c_str());
+}
+bool ArrayCondition::EvaluateImpl(RE::TESObjectREFR *a_refr,
+                                  RE::hkbClipGenerator *, void *) const {
+  float dist = 0.0f;
+  if (!ReadElement(a_refr, dist))
+    return false;
+  return comparisonComponent->GetComparisonResult(
+      dist, valueComponent->GetNumericValue(a_refr));
 }
 } // namespace OARConditions
@@ -1,13 +1,41 @@
 #pragma once
 
 #include "API/OpenAnimationReplacerAPI-Conditions.h"
+#include "ConditionProfiler.h"
 #include "RaySenseLogic.h"
+#include "SensorChannels.h"
 
 namespace OARConditions {
 using namespace OAR_API::Conditions;
 
+// Common base for all RaySense conditions.
+// Wraps OAR's Evaluate to optionally record per-instance profiling data and
+// replacement telemetry.
+class RaySenseCondition : public Conditions::CustomCondition {
+public:
+  ~RaySenseCondition() override;
+
+  // Sensor channel this condition reads
+  [[nodiscard]] virtual Channel GetChannel() const = 0;
+
+  bool Evaluate(RE::TESObjectREFR *a_refr,
+                RE::hkbClipGenerator *a_clipGenerator,
+                void *a_parentSubMod) const override;
+  void PostInitialize() override;
+
+protected:
+  // Reads GetChannel() for a_refr; false while no value is available
+  bool ReadChannel(RE::TESObjectREFR *a_refr, float &a_value) const;
+
+private:
+  void RegisterProfile() const;
+
+  mutable ConditionProfiler::Counters _profile;
+  mutable std::atomic<bool> _profileRegistered{false};
+};
+
 // Condition to check verticality differences (Front, Left, Right, PlayerHeight)
-class VerticalityCondition : public Conditions::CustomCondition {
+class VerticalityCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "RaySense_Verticality"sv;
@@ -24,12 +52,18 @@ public:
 
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override;
 
 protected:
+  static constexpr int SENSOR_COUNT = 15;
+
   bool EvaluateImpl(RE::TESObjectREFR *a_refr,
                     RE::hkbClipGenerator *a_clipGenerator,
                     void *a_subMod) const override;
 
+  static bool ReadSensor(RE::TESObjectREFR *a_refr, int a_index,
+                         float &a_value);
+
   Conditions::INumericConditionComponent
       *sensorIndexComponent; // 0: Front, 1: Left, 2: Right, 3: PlayerHeight
   Conditions::IComparisonConditionComponent *comparisonComponent;
@@ -37,7 +71,7 @@ protected:
 };
 
 // Condition to check obstacle distance
-class ObstacleCondition : public Conditions::CustomCondition {
+class ObstacleCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "RaySense_Obstacle"sv;
@@ -54,6 +88,7 @@ public:
 
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override { return Channel::kObstacle; }
 
 protected:
   bool EvaluateImpl(RE::TESObjectREFR *a_refr,
@@ -65,7 +100,7 @@ protected:
 };
 
 // Condition to check FRONT wall distance
-class WallFrontCondition : public Conditions::CustomCondition {
+class WallFrontCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "RaySense_Wall_Front"sv;
@@ -79,6 +114,7 @@ public:
   }
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override { return Channel::kWallFront; }
 
 protected:
   bool EvaluateImpl(RE::TESObjectREFR *a_refr, RE::hkbClipGenerator *a_cg,
@@ -88,7 +124,7 @@ protected:
 };
 
 // Condition to check FRONT LEFT wall distance
-class WallFrontLCondition : public Conditions::CustomCondition {
+class WallFrontLCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "RaySense_Wall_Front_L"sv;
@@ -102,6 +138,7 @@ public:
   }
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override { return Channel::kWallFrontL; }
 
 protected:
   bool EvaluateImpl(RE::TESObjectREFR *a_refr, RE::hkbClipGenerator *a_cg,
@@ -111,7 +148,7 @@ protected:
 };
 
 // Condition to check FRONT RIGHT wall distance
-class WallFrontRCondition : public Conditions::CustomCondition {
+class WallFrontRCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "RaySense_Wall_Front_R"sv;
@@ -125,6 +162,7 @@ public:
   }
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override { return Channel::kWallFrontR; }
 
 protected:
   bool EvaluateImpl(RE::TESObjectREFR *a_refr, RE::hkbClipGenerator *a_cg,
@@ -134,7 +172,7 @@ protected:
 };
 
 // Condition to check LEFT wall distance
-class WallLeftCondition : public Conditions::CustomCondition {
+class WallLeftCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "RaySense_Wall_Left"sv;
@@ -148,6 +186,7 @@ public:
   }
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override { return Channel::kWallLeft; }
 
 protected:
   bool EvaluateImpl(RE::TESObjectREFR *a_refr, RE::hkbClipGenerator *a_cg,
@@ -157,7 +196,7 @@ protected:
 };
 
 // Condition to check RIGHT wall distance
-class WallRightCondition : public Conditions::CustomCondition {
+class WallRightCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "RaySense_Wall_Right"sv;
@@ -171,6 +210,7 @@ public:
   }
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override { return Channel::kWallRight; }
 
 protected:
   bool EvaluateImpl(RE::TESObjectREFR *a_refr, RE::hkbClipGenerator *a_cg,
@@ -180,7 +220,7 @@ protected:
 };
 
 // Condition to check FRONT obstacle FormType
-class ObstacleTypeFrontCondition : public Conditions::CustomCondition {
+class ObstacleTypeFrontCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "Obstacle_Type_Front"sv;
@@ -194,6 +234,7 @@ public:
   }
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override { return Channel::kObstacleTypeFront; }
 
 protected:
   bool EvaluateImpl(RE::TESObjectREFR *a_refr, RE::hkbClipGenerator *a_cg,
@@ -203,7 +244,7 @@ protected:
 };
 
 // Condition to check LEFT obstacle FormType
-class ObstacleTypeLeftCondition : public Conditions::CustomCondition {
+class ObstacleTypeLeftCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "Obstacle_Type_Left"sv;
@@ -217,6 +258,7 @@ public:
   }
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override { return Channel::kObstacleTypeLeft; }
 
 protected:
   bool EvaluateImpl(RE::TESObjectREFR *a_refr, RE::hkbClipGenerator *a_cg,
@@ -226,7 +268,7 @@ protected:
 };
 
 // Condition to check RIGHT obstacle FormType
-class ObstacleTypeRightCondition : public Conditions::CustomCondition {
+class ObstacleTypeRightCondition : public RaySenseCondition {
 public:
   constexpr static inline std::string_view CONDITION_NAME =
       "Obstacle_Type_Right"sv;
@@ -240,6 +282,7 @@ public:
   }
   RE::BSString GetArgument() const override;
   RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  Channel GetChannel() const override { return Channel::kObstacleTypeRight; }
 
 protected:
   bool EvaluateImpl(RE::TESObjectREFR *a_refr, RE::hkbClipGenerator *a_cg,
@@ -247,4 +290,32 @@ protected:
   Conditions::IComparisonConditionComponent *comparisonComponent;
   Conditions::INumericConditionComponent *valueComponent;
 };
+
+// Condition to check the distance along one ray of the [Array] sensor ring
+class ArrayCondition : public RaySenseCondition {
+public:
+  constexpr static inline std::string_view CONDITION_NAME = "RaySense_Array"sv;
+  ArrayCondition();
+  RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+  RE::BSString GetDescription() const override {
+    return "Checks distance along one ray of the sensor array."sv.data();
+  }
+  constexpr REL::Version GetRequiredVersion() const override {
+    return {1, 0, 0};
+  }
+  RE::BSString GetArgument() const override;
+  RE::BSString GetCurrent(RE::TESObjectREFR *a_refr) const override;
+  // Sweeps, telemetry and latency track the array through its summary
+  Channel GetChannel() const override { return Channel::kArrayNearest; }
+
+protected:
+  bool EvaluateImpl(RE::TESObjectREFR *a_refr, RE::hkbClipGenerator *a_cg,
+                    void *a_sm) const override;
+  bool ReadElement(RE::TESObjectREFR *a_refr, float &a_value) const;
+  Conditions::INumericConditionComponent
+      *directionComponent; // 0 = ahead, clockwise
+  Conditions::INumericConditionComponent *heightComponent; // Ring index
+  Conditions::IComparisonConditionComponent *comparisonComponent;
+  Conditions::INumericConditionComponent *valueComponent;
+};
 } // namespace OARConditions
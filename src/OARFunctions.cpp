@@ -0,0 +1,150 @@
+#include "OARFunctions.h"
+#include "RaySenseLogic.h"
+#include <bit>
+#include <cmath>
+
+namespace OARFunctions {
+namespace {
+constexpr float RAD_TO_DEG = 180.0f / 3.1415926535f;
+
+// First channel named in a_text, or a_default when it names none
+Channel ParseChannel(const RE::BSString &a_text, Channel a_default) {
+  const ChannelMask mask = ParseChannels(std::string_view(a_text.c_str()));
+  return mask ? static_cast<Channel>(std::countr_zero(mask)) : a_default;
+}
+} // namespace
+
+// --- ResampleFunction ---
+
+ResampleFunction::ResampleFunction() {
+  channelsComponent = static_cast<Functions::ITextFunctionComponent *>(
+      AddBaseComponent(Functions::FunctionComponentType::kText, "Channels",
+                       "Comma-separated channel names, or All"));
+  channelsComponent->SetAllowSpaces(true);
+}
+
+RE::BSString ResampleFunction::GetArgument() const {
+  return channelsComponent->GetTextValue();
+}
+
+bool ResampleFunction::RunImpl(RE::TESObjectREFR *a_refr,
+                               RE::hkbClipGenerator *, void *,
+                               Functions::Trigger *) const {
+  auto *actor = a_refr ? a_refr->As<RE::Actor>() : nullptr;
+  if (!actor)
+    return false;
+
+  const auto text = channelsComponent->GetTextValue();
+  const ChannelMask channels =
+      ParseChannels(text.empty() ? "All"sv : std::string_view(text.c_str()));
+  return RaySenseLogic::GetSingleton()->Resample(actor, channels);
+}
+
+// --- AlignToHitFunction ---
+
+AlignToHitFunction::AlignToHitFunction() {
+  channelComponent = static_cast<Functions::ITextFunctionComponent *>(
+      AddBaseComponent(Functions::FunctionComponentType::kText, "Channel",
+                       "Channel name, WallFront when empty"));
+  moveComponent = static_cast<Functions::IBoolFunctionComponent *>(
+      AddBaseComponent(Functions::FunctionComponentType::kBool, "Move",
+                       "Also move the actor to Distance from the hit"));
+  distanceComponent = static_cast<Functions::INumericFunctionComponent *>(
+      AddBaseComponent(Functions::FunctionComponentType::kNumeric, "Distance",
+                       "Distance kept from the hit point when moving"));
+}
+
+RE::BSString AlignToHitFunction::GetArgument() const {
+  return channelComponent->GetTextValue();
+}
+
+bool AlignToHitFunction::RunImpl(RE::TESObjectREFR *a_refr,
+                                 RE::hkbClipGenerator *, void *,
+                                 Functions::Trigger *) const {
+  auto *actor = a_refr ? a_refr->As<RE::Actor>() : nullptr;
+  RaySenseLogic::HitSample hit;
+  if (!actor ||
+      !RaySenseLogic::GetSingleton()->GetHit(
+          actor,
+          ParseChannel(channelComponent->GetTextValue(), Channel::kWallFront),
+          hit))
+    return false;
+
+  // Floors and ceilings have no direction to face
+  RE::NiPoint3 normal(hit.normal.x, hit.normal.y, 0.0f);
+  if (normal.Unitize() < 0.1f)
+    return false;
+
+  const float heading = std::atan2(-normal.x, -normal.y);
+  const bool move = moveComponent->GetBoolValue();
+  const float distance = distanceComponent->GetNumericValue(a_refr);
+  const RE::NiPoint3 target = hit.point + normal * distance;
+
+  // Graph threads must not move references; apply on the main thread
+  auto *tasks = SKSE::GetTaskInterface();
+  if (!tasks)
+    return false;
+  tasks->AddTask([handle = actor->GetHandle(), heading, move, target]() {
+    auto refr = handle.get();
+    if (!refr || !refr->Is3DLoaded())
+      return;
+    refr->SetHeading(heading);
+    if (move)
+      refr->SetPosition(target.x, target.y, refr->GetPositionZ());
+  });
+  return true;
+}
+
+// --- SetGraphVarsFromHitFunction ---
+
+SetGraphVarsFromHitFunction::SetGraphVarsFromHitFunction() {
+  channelComponent = static_cast<Functions::ITextFunctionComponent *>(
+      AddBaseComponent(Functions::FunctionComponentType::kText, "Channel",
+                       "Channel name, WallFront when empty"));
+  prefixComponent = static_cast<Functions::ITextFunctionComponent *>(
+      AddBaseComponent(Functions::FunctionComponentType::kText, "Prefix",
+                       "Graph variable prefix, RaySense when empty"));
+}
+
+RE::BSString SetGraphVarsFromHitFunction::GetArgument() const {
+  return channelComponent->GetTextValue();
+}
+
+bool SetGraphVarsFromHitFunction::RunImpl(RE::TESObjectREFR *a_refr,
+                                          RE::hkbClipGenerator *, void *,
+                                          Functions::Trigger *) const {
+  auto *actor = a_refr ? a_refr->As<RE::Actor>() : nullptr;
+  RaySenseLogic::HitSample hit;
+  if (!actor ||
+      !RaySenseLogic::GetSingleton()->GetHit(
+          actor,
+          ParseChannel(channelComponent->GetTextValue(), Channel::kWallFront),
+          hit))
+    return false;
+
+  const float angle = actor->GetAngleZ();
+  const RE::NiPoint3 forward(std::sin(angle), std::cos(angle), 0.0f);
+  const RE::NiPoint3 right(forward.y, -forward.x, 0.0f);
+  const RE::NiPoint3 offset = hit.point - actor->GetPosition();
+
+  // Normal turned into the actor's frame: 0 when it points back at the actor
+  const float normalYaw =
+      std::atan2(-hit.normal.Dot(right), -hit.normal.Dot(forward)) *
+      RAD_TO_DEG;
+
+  const auto text = prefixComponent->GetTextValue();
+  const std::string prefix = text.empty() ? "RaySense" : text.c_str();
+  const std::pair<const char *, float> vars[] = {
+      {"HitX", offset.Dot(right)},
+      {"HitY", offset.Dot(forward)},
+      {"HitZ", offset.z},
+      {"HitDistance", offset.Length()},
+      {"NormalYaw", normalYaw},
+      {"NormalZ", hit.normal.z}};
+
+  bool any = false;
+  for (const auto &[name, value] : vars)
+    any |= actor->SetGraphVariableFloat((prefix + name).c_str(), value);
+  return any;
+}
+} // namespace OARFunctions
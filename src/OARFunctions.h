@@ -0,0 +1,101 @@
+#pragma once
+
+#include "API/OpenAnimationReplacerAPI-Functions.h"
+#include "SensorChannels.h"
+
+namespace OARFunctions {
+using namespace OAR_API::Functions;
+
+// Forces a fresh sample of the listed channels for the refr (the player's on
+// its next update), so a pack can sense at a low background rate and still
+// decide on current values when a clip activates or an annotation fires.
+class ResampleFunction : public Functions::CustomFunction {
+public:
+  constexpr static inline std::string_view FUNCTION_NAME =
+      "RaySense_Resample"sv;
+
+  ResampleFunction();
+
+  RE::BSString GetName() const override { return FUNCTION_NAME.data(); }
+  RE::BSString GetDescription() const override {
+    return "Resamples RaySense channels before they are read again."sv
+        .data();
+  }
+  constexpr REL::Version GetRequiredVersion() const override {
+    return {1, 0, 0};
+  }
+
+  RE::BSString GetArgument() const override;
+
+protected:
+  bool RunImpl(RE::TESObjectREFR *a_refr,
+               RE::hkbClipGenerator *a_clipGenerator, void *a_subMod,
+               Functions::Trigger *a_trigger) const override;
+
+  // Comma-separated channel names as in [Profile] sChannels, or "All"
+  Functions::ITextFunctionComponent *channelsComponent;
+};
+
+// Turns the actor to face the surface a channel's last ray hit, optionally
+// stepping it to a fixed distance from the hit point. Uses the stored hit,
+// so no ray is cast; player only.
+class AlignToHitFunction : public Functions::CustomFunction {
+public:
+  constexpr static inline std::string_view FUNCTION_NAME =
+      "RaySense_AlignToHit"sv;
+
+  AlignToHitFunction();
+
+  RE::BSString GetName() const override { return FUNCTION_NAME.data(); }
+  RE::BSString GetDescription() const override {
+    return "Faces the actor toward the last hit of a RaySense channel."sv
+        .data();
+  }
+  constexpr REL::Version GetRequiredVersion() const override {
+    return {1, 0, 0};
+  }
+
+  RE::BSString GetArgument() const override;
+
+protected:
+  bool RunImpl(RE::TESObjectREFR *a_refr,
+               RE::hkbClipGenerator *a_clipGenerator, void *a_subMod,
+               Functions::Trigger *a_trigger) const override;
+
+  Functions::ITextFunctionComponent *channelComponent;
+  Functions::IBoolFunctionComponent *moveComponent;
+  // Distance kept from the hit point along its normal when moving
+  Functions::INumericFunctionComponent *distanceComponent;
+};
+
+// Writes a channel's last hit to behavior graph variables, relative to the
+// actor: <Prefix>HitX/Y/Z (right, forward, up), <Prefix>HitDistance,
+// <Prefix>NormalYaw (degrees, 0 = facing the actor) and <Prefix>NormalZ.
+// Variables the graph does not define are skipped; player only.
+class SetGraphVarsFromHitFunction : public Functions::CustomFunction {
+public:
+  constexpr static inline std::string_view FUNCTION_NAME =
+      "RaySense_SetGraphVarsFromHit"sv;
+
+  SetGraphVarsFromHitFunction();
+
+  RE::BSString GetName() const override { return FUNCTION_NAME.data(); }
+  RE::BSString GetDescription() const override {
+    return "Sets graph variables from the last hit of a RaySense channel."sv
+        .data();
+  }
+  constexpr REL::Version GetRequiredVersion() const override {
+    return {1, 0, 0};
+  }
+
+  RE::BSString GetArgument() const override;
+
+protected:
+  bool RunImpl(RE::TESObjectREFR *a_refr,
+               RE::hkbClipGenerator *a_clipGenerator, void *a_subMod,
+               Functions::Trigger *a_trigger) const override;
+
+  Functions::ITextFunctionComponent *channelComponent;
+  Functions::ITextFunctionComponent *prefixComponent;
+};
+} // namespace OARFunctions
@@ -1,79 +1,151 @@
 #include "RaySenseLogic.h"
+#include "ActorSensorCache.h"
+#include "ClipSuppression.h"
+#include "CollidableCache.h"
+#include "FootstepEvents.h"
+#include "SenseLatency.h"
+#include "SensorProfiles.h"
+#include "Settings.h"
+#include "SpatialProfiler.h"
+#include "Trace.h"
+#include "WaterCache.h"
 #include "RE/B/bhkWorld.h"
 #include "RE/H/hkpWorld.h"
 #include "RE/H/hkpWorldRayCastInput.h"
 #include "RE/H/hkpWorldRayCastOutput.h"
 #include "RE/T/TESObjectCELL.h"
+#include <algorithm>
 #include <cmath>
+#include <thread>
+
+namespace {
+// Global mirrored by each channel, in Channel order
+constexpr std::string_view CHANNEL_GLOBALS[] = {
+    "Verticality_Front",
+    "Verticality_Left",
+    "Verticality_Right",
+    "Verticality_Player",
+    "RaySense_SurfaceType",
+    "RaySense_PlatformType",
+    "Verticality_Obstacle",
+    "RaySense_Wall_Front",
+    "RaySense_Wall_Front_L",
+    "RaySense_Wall_Front_R",
+    "RaySense_Wall_Left",
+    "RaySense_Wall_Right",
+    "Obstacle_Type_Front",
+    "Obstacle_Type_Left",
+    "Obstacle_Type_Right",
+    "RaySense_WaterDepth",
+    "RaySense_WaterAhead",
+    "RaySense_ShoreDistance",
+    "RaySense_LandingTime",
+    "RaySense_LandingHeight",
+    "RaySense_LandingSurface",
+    "RaySense_FrontRoughness",
+    "RaySense_WallRoughness",
+    "RaySense_ArrayNearest",
+};
+static_assert(std::size(CHANNEL_GLOBALS) == CHANNEL_COUNT);
+
+TemporalSampler::Point ToPoint(const RE::NiPoint3 &a_point) {
+  return {a_point.x, a_point.y, a_point.z};
+}
+} // namespace
 
 void RaySenseLogic::Install() {
   SKSE::log::info("RaySenseLogic: Starting Installation...");
 
-  _verticalityFrontGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("Verticality_Front");
-  _verticalityLeftGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("Verticality_Left");
-  _verticalityRightGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("Verticality_Right");
-  _verticalityObstacleGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("Verticality_Obstacle");
-  _wallFrontGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("RaySense_Wall_Front");
-  _wallFrontLGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("RaySense_Wall_Front_L");
-  _wallFrontRGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("RaySense_Wall_Front_R");
-  _wallLeftGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("RaySense_Wall_Left");
-  _wallRightGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("RaySense_Wall_Right");
-  _obstacleTypeFrontGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("Obstacle_Type_Front");
-  _obstacleTypeLeftGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("Obstacle_Type_Left");
-  _obstacleTypeRightGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("Obstacle_Type_Right");
-  _verticalityPlayerGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("Verticality_Player");
-  _surfaceTypeGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("RaySense_SurfaceType");
-  _platformTypeGlobal =
-      RE::TESForm::LookupByEditorID<RE::TESGlobal>("RaySense_PlatformType");
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    _globals[i] =
+        RE::TESForm::LookupByEditorID<RE::TESGlobal>(CHANNEL_GLOBALS[i]);
+    if (_globals[i])
+      SKSE::log::info("RaySenseLogic: Found Global {}", CHANNEL_GLOBALS[i]);
+  }
+
   _rawMaterialIDGlobal =
       RE::TESForm::LookupByEditorID<RE::TESGlobal>("RaySense_RawMID");
   _rawLayerIDGlobal =
       RE::TESForm::LookupByEditorID<RE::TESGlobal>("RaySense_RawLayer");
 
-  if (_verticalityFrontGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global Verticality_Front");
-  if (_verticalityLeftGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global Verticality_Left");
-  if (_verticalityRightGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global Verticality_Right");
-  if (_verticalityObstacleGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global Verticality_Obstacle");
-  if (_wallFrontGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global RaySense_Wall_Front");
-  if (_wallFrontLGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global RaySense_Wall_Front_L");
-  if (_wallFrontRGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global RaySense_Wall_Front_R");
-  if (_wallLeftGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global RaySense_Wall_Left");
-  if (_wallRightGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global RaySense_Wall_Right");
-  if (_obstacleTypeFrontGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global Obstacle_Type_Front");
-  if (_obstacleTypeLeftGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global Obstacle_Type_Left");
-  if (_obstacleTypeRightGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global Obstacle_Type_Right");
-  if (_verticalityPlayerGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global Verticality_Player");
-  if (_surfaceTypeGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global RaySense_SurfaceType");
-  if (_platformTypeGlobal)
-    SKSE::log::info("RaySenseLogic: Found Global RaySense_PlatformType");
+  // Registration order is priority order and matches SensorTask
+  _governor.AddTask("Front",
+                    ToMask(Channel::kFront) | ToMask(Channel::kFrontRoughness));
+  _governor.AddTask("PlayerHeight", ToMask(Channel::kPlayerHeight));
+  _governor.AddTask("Obstacle",
+                    ToMask(Channel::kObstacle) | ToMask(Channel::kWallFront) |
+                        ToMask(Channel::kWallFrontL) |
+                        ToMask(Channel::kWallFrontR) |
+                        ToMask(Channel::kWallLeft) |
+                        ToMask(Channel::kWallRight) |
+                        ToMask(Channel::kWallRoughness));
+  _governor.AddTask("Left", ToMask(Channel::kLeft));
+  _governor.AddTask("Right", ToMask(Channel::kRight));
+  _governor.AddTask("ObstacleType", ToMask(Channel::kObstacleTypeFront) |
+                                        ToMask(Channel::kObstacleTypeLeft) |
+                                        ToMask(Channel::kObstacleTypeRight));
+  _governor.AddTask("Landing", LANDING_CHANNELS);
+  _governor.AddTask("Array", ToMask(Channel::kArrayNearest));
+  _governor.SetBudget(Settings::GetSingleton()->sensorBudgetUs);
+
+  const auto tickHz = Settings::GetSingleton()->sensorTickHz;
+  _tickInterval = tickHz > 0.0f ? 1.0f / tickHz : 0.0f;
+  _tickMidairFullRate = Settings::GetSingleton()->tickMidairFullRate;
+  if (_tickInterval > 0.0f)
+    SKSE::log::info("RaySenseLogic: Sensing at {:.0f} Hz", tickHz);
+
+  const auto fallbackHz = Settings::GetSingleton()->surfaceFallbackHz;
+  _surfaceInterval = fallbackHz > 0.0f ? 1.0f / fallbackHz : 0.0f;
+  _surfaceElapsed = _surfaceInterval;
+  FootstepEvents::GetSingleton()->Configure(
+      Settings::GetSingleton()->surfaceFootstepEvents);
+  _predictPosition = Settings::GetSingleton()->sampleFirst;
+
+  const auto *settings = Settings::GetSingleton();
+  _landingSegments = settings->landingMaxSegments;
+  _landingSegmentLength = settings->landingSegmentLength;
+  _reactionTime = settings->lookaheadReactionTime;
+  _minOffset = settings->lookaheadMinOffset;
+  _maxOffset = settings->lookaheadMaxOffset;
+  _minReach = settings->lookaheadMinReach;
+  if (_reactionTime > 0.0f)
+    SKSE::log::info("RaySenseLogic: Lookahead of {:.2f}s", _reactionTime);
+  if (settings->supersampleFrames > 1) {
+    _jitterRadius = settings->supersampleRadius;
+    // Offset phases so channels sensed together do not jitter in lockstep
+    for (std::uint32_t i = 0; i < CHANNEL_COUNT; ++i)
+      _samplers[i].Configure(settings->supersampleFrames, i);
+    SKSE::log::info("RaySenseLogic: Supersampling over {} frames",
+                    settings->supersampleFrames);
+  }
+  _array.Configure(settings->arrayDirections, settings->arrayHeights,
+                   settings->arrayReach, settings->arrayBackReach);
+  for (std::uint32_t i = 0; i < _array.GetCount(); ++i) {
+    _arraySweep[i] = _array.GetElement(i).reach;
+    _arrayValues[i].store(_arraySweep[i], std::memory_order_relaxed);
+  }
+  if (_array.IsEnabled()) {
+    SKSE::log::info("RaySenseLogic: Sensor array of {} directions x {} "
+                    "heights",
+                    _array.GetDirections(), _array.GetHeights());
+  }
+
+  const auto threads = Settings::GetSingleton()->sensorThreads;
+  if (threads > 1) {
+    // Fanning ten short jobs out only pays off with cores to spare
+    if (std::thread::hardware_concurrency() >= 4) {
+      _pool.Start(threads);
+      // Helpers cast, classify and record off the game thread, which the
+      // engine does not promise to allow
+      SKSE::log::warn("RaySenseLogic: Sensor pool with {} threads is "
+                      "experimental; jobs query Havok and references off "
+                      "the game thread",
+                      _pool.GetThreadCount());
+    } else {
+      SKSE::log::info("RaySenseLogic: Sensor pool disabled, {} cores",
+                      std::thread::hardware_concurrency());
+    }
+  }
 
   SKSE::log::info("RaySenseLogic: Installation Complete.");
 }
@@ -86,13 +158,221 @@ void RaySenseLogic::OnJump(RE::PlayerCharacter *a_player) {
   // OnUpdate already handles these every frame.
 }
 
+void RaySenseLogic::Reset() {
+  std::scoped_lock senseLock(_senseLock);
+  _governor.Clear();
+  ClearHits(SWEEP_CHANNELS);
+  ClearSamples(SWEEP_CHANNELS);
+  _dirty = SWEEP_CHANNELS;
+  _warmupTask = 0;
+  _lastCell = nullptr;
+  _lastWorldspace = nullptr;
+  _tickAccumulator = 0.0f;
+  _elapsedSinceUpdate = 0.0f;
+  _surfaceCache = {};
+  _surfaceElapsed = _surfaceInterval; // Sample on the next tick
+  _heightSupport = nullptr;
+  _landMaterials.Clear();
+  {
+    std::scoped_lock lock(_hitSampleLock);
+    _hitSamples = {};
+  }
+  for (std::uint32_t i = 0; i < _array.GetCount(); ++i) {
+    _arraySweep[i] = _array.GetElement(i).reach;
+    _arrayValues[i].store(_arraySweep[i], std::memory_order_relaxed);
+  }
+  _initialized = false;
+}
+
+bool RaySenseLogic::GetArrayValue(RE::TESObjectREFR *a_refr,
+                                  std::uint32_t a_direction,
+                                  std::uint32_t a_height,
+                                  float &a_value) const {
+  if (!a_refr || !a_refr->IsPlayerRef())
+    return false;
+  const auto index = _array.GetIndex(a_direction, a_height);
+  if (index >= _array.GetCount())
+    return false;
+  a_value = _arrayValues[index].load(std::memory_order_relaxed);
+  return true;
+}
+
+bool RaySenseLogic::GetChannelValue(RE::TESObjectREFR *a_refr,
+                                    Channel a_channel, float &a_value) const {
+  if (!a_refr)
+    return false;
+
+  if (a_refr->IsPlayerRef()) {
+    a_value = GetValue(a_channel);
+    return true;
+  }
+  return ActorSensorCache::GetSingleton()->GetValue(a_refr, a_channel,
+                                                    a_value);
+}
+
+bool RaySenseLogic::GetHit(RE::TESObjectREFR *a_refr, Channel a_channel,
+                           HitSample &a_hit) const {
+  if (!a_refr || !a_refr->IsPlayerRef() || ToIndex(a_channel) >= CHANNEL_COUNT)
+    return false;
+
+  std::scoped_lock lock(_hitSampleLock);
+  a_hit = _hitSamples[ToIndex(a_channel)];
+  return a_hit.valid;
+}
+
+void RaySenseLogic::Publish(const SensorValues &a_values,
+                            ChannelMask a_channels) {
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    if (!(a_channels & (1u << i)))
+      continue;
+    _values[i].store(a_values[i], std::memory_order_relaxed);
+    if (_globals[i])
+      _globals[i]->value = a_values[i];
+  }
+  // Array elements go out with their nearest distance
+  if (a_channels & ToMask(Channel::kArrayNearest)) {
+    for (std::uint32_t i = 0; i < _array.GetCount(); ++i)
+      _arrayValues[i].store(_arraySweep[i], std::memory_order_relaxed);
+  }
+  if (SenseLatency::IsEnabled())
+    SenseLatency::GetSingleton()->Stamp(a_channels);
+}
+
+void RaySenseLogic::GetHeading(RE::Actor *a_actor, RE::NiPoint3 &a_forward,
+                               RE::NiPoint3 &a_right) {
+  a_forward = {0.0f, 1.0f, 0.0f};
+  a_right = {1.0f, 0.0f, 0.0f};
+
+  if (auto root = a_actor->Get3D()) {
+    const auto &m = root->world.rotate;
+    RE::NiPoint3 f = {m.entry[0][1], m.entry[1][1], m.entry[2][1]};
+    RE::NiPoint3 r = {m.entry[0][0], m.entry[1][0], m.entry[2][0]};
+
+    if (IsFinite(f) && IsFinite(r)) {
+      a_forward = f;
+      a_right = r;
+    }
+  }
+}
+
+const void *RaySenseLogic::GetStableSupport(RE::Actor *a_actor) {
+  auto *controller = a_actor->GetCharController();
+  if (!controller ||
+      controller->context.currentState !=
+          RE::hkpCharacterStateType::kOnGround ||
+      controller->surfaceInfo.supportedState !=
+          RE::hkpSurfaceInfo::SupportedState::kSupported)
+    return nullptr;
+
+  // Only compared, never dereferenced
+  return controller->supportBody.get();
+}
+
+void RaySenseLogic::BuildFrame(RE::Actor *a_actor, SensorFrame &a_frame) {
+  a_frame.actor = a_actor;
+  a_frame.pos = a_actor->GetPosition();
+  GetHeading(a_actor, a_frame.forward, a_frame.right);
+  a_frame.left = a_frame.right * -1.0f;
+  a_frame.vel = RE::NiPoint3(0.0f, 0.0f, 0.0f);
+  a_frame.angle = a_actor->data.angle.z;
+  a_frame.midair = a_actor->IsInMidair();
+
+  // Strafing or turning sensors follow where the actor actually goes
+  a_frame.ahead = a_frame.forward;
+  a_frame.aheadRight = a_frame.right;
+  a_frame.speed = 0.0f;
+  if (a_frame.midair)
+    return;
+  RE::NiPoint3 velocity;
+  a_actor->GetLinearVelocity(velocity);
+  velocity.z = 0.0f;
+  const float speed = velocity.Length();
+  if (!std::isfinite(speed) || speed < MIN_INTENT_SPEED)
+    return;
+  a_frame.speed = speed;
+  a_frame.ahead = velocity / speed;
+  a_frame.aheadRight = RE::NiPoint3(a_frame.ahead.y, -a_frame.ahead.x, 0.0f);
+}
+
+void RaySenseLogic::FindWater(RE::Actor *a_actor, SensorFrame &a_frame) {
+  auto *cell = a_actor->GetParentCell();
+  WaterCache::Plane plane;
+  if (WaterCache::GetSingleton()->GetPlane(cell, a_frame.pos, plane)) {
+    a_frame.waterHeight = plane.height;
+    a_frame.hasWater = true;
+  }
+}
+
+float RaySenseLogic::GetFrontOffset(const SensorFrame &a_frame) const {
+  if (_reactionTime <= 0.0f)
+    return FRONT_OFFSET;
+  return std::clamp(a_frame.speed * _reactionTime, _minOffset, _maxOffset);
+}
+
+float RaySenseLogic::GetObstacleReach(const SensorFrame &a_frame,
+                                      bool a_sprinting) const {
+  if (_reactionTime <= 0.0f)
+    return a_sprinting ? _profile.sprintObstacleReach : _profile.obstacleReach;
+
+  // The profile reaches stay the upper bound
+  const float maxReach =
+      std::max(_profile.obstacleReach, _profile.sprintObstacleReach);
+  const float minReach = std::min(_minReach, maxReach);
+  return std::clamp(a_frame.speed * _reactionTime, minReach, maxReach);
+}
+
 void RaySenseLogic::OnUpdate(RE::PlayerCharacter *a_player, float a_delta) {
   if (!a_player || a_delta <= 0.0f || !a_player->Is3DLoaded() ||
       a_player->IsDead() || a_player->IsInKillMove())
     return;
 
+  // NPC resamples from animation threads wait for this update
+  std::scoped_lock senseLock(_senseLock);
+
+  // [Clip Suppression]
+  // Held channels are neither cast nor published while a committed clip
+  // plays; they stay dirty and resample once it ends.
+  _suppressed =
+      ClipSuppression::GetSingleton()->Update(a_delta) & SWEEP_CHANNELS;
+
+  // [Resample]
+  // Requests from graph threads are served here, so only the main thread
+  // (and the pool it waits for) touches the player's sensing state
+  const ChannelMask requested =
+      _resampleRequested.exchange(0, std::memory_order_relaxed);
+
+  // Rays cast by this update count toward the active profile
+  struct ProfileFrame {
+    std::uint32_t index;
+    std::uint64_t raysBefore;
+    std::uint64_t avoidedBefore;
+    ~ProfileFrame() {
+      SensorProfiles::GetSingleton()->AddFrame(
+          index, _rayCount.load(std::memory_order_relaxed) - raysBefore,
+          _raysAvoided.load(std::memory_order_relaxed) - avoidedBefore);
+    }
+  } profileFrame{_profileIndex, _rayCount.load(std::memory_order_relaxed),
+                 _raysAvoided.load(std::memory_order_relaxed)};
+
+  // [Fixed Tick]
+  // Rays are cast at the configured rate rather than every rendered frame;
+  // frames in between extrapolate the last sample. Landing prediction may
+  // keep the full rate; nothing else does.
+  _elapsedSinceUpdate += a_delta;
+  const bool tick = AdvanceTick(a_delta);
+  const bool landingRate =
+      !tick && _tickMidairFullRate && a_player->IsInMidair();
+
   // Surface Info should update even when swimming or mounted
-  UpdateSurfaceInfo(a_player);
+  _surfaceElapsed += a_delta;
+  const bool surfaceRequested = requested & SURFACE_CHANNELS;
+  if (tick || surfaceRequested) {
+    UpdateWaterInfo(a_player, _sweepValues);
+    RE::NiPoint3 origin;
+    if (TakeSurfaceSample(a_player, surfaceRequested, origin))
+      UpdateSurfaceInfo(a_player, origin, _sweepValues);
+    Publish(_sweepValues, SURFACE_CHANNELS);
+  }
 
   if (auto *state = a_player->AsActorState()) {
     if (a_player->IsOnMount() || state->IsSwimming()) {
@@ -101,230 +381,870 @@ void RaySenseLogic::OnUpdate(RE::PlayerCharacter *a_player, float a_delta) {
   }
 
   RE::NiPoint3 currentPos = a_player->GetPosition();
-  float currentAngle = a_player->data.angle.z;
+  if (!IsFinite(currentPos)) {
+    return;
+  }
+
+  // Sensing ahead of the player update: sample where this update will leave
+  // the player, not where the last one did
+  if (_predictPosition) {
+    RE::NiPoint3 velocity;
+    a_player->GetLinearVelocity(velocity);
+    if (IsFinite(velocity) && velocity.SqrLength() < MAX_PREDICT_SPEED_SQ)
+      currentPos += velocity * a_delta;
+  }
+
+  if (requested & SWEEP_CHANNELS & _profile.channels)
+    ResamplePlayer(a_player, requested);
+
+  // Carried-over governor work still resumes every frame
+  if (!tick && !landingRate && _governor.IsIdle()) {
+    if (_initialized)
+      Extrapolate(currentPos);
+    return;
+  }
+
+  SensorFrame frame;
+  BuildFrame(a_player, frame);
+  frame.pos = currentPos;
+  if (frame.midair)
+    FindWater(a_player, frame);
 
   // [Smart Caching]
-  // Skip heavy calculations if player is stationary
-  if (_initialized) {
-    float distSq = currentPos.GetSquaredDistance(_lastUpdatePos);
-    float angleDiff = std::abs(currentAngle - _lastUpdateAngle);
+  // Only channels invalidated by player motion, a world change or a moving
+  // body they hit are recomputed; a static scene stays fully cached.
+  _dirty = (_dirty | CollectDirty(a_player, frame)) & _profile.channels;
+  // Between ticks the other channels stay dirty until the next one
+  const ChannelMask due =
+      _dirty & ~_suppressed & (tick ? SWEEP_CHANNELS : MIDAIR_CHANNELS);
+  if (landingRate && _initialized)
+    Extrapolate(currentPos, MIDAIR_CHANNELS);
+  if (SenseLatency::IsEnabled() && _initialized) {
+    // Clean channels already hold this update's answer
+    SenseLatency::GetSingleton()->Stamp(SWEEP_CHANNELS & _profile.channels &
+                                        ~_dirty);
+  }
+  if (_governor.IsIdle() && !due) {
+    // Still at the sampled position, so velocity restarts from here
+    _elapsedSinceUpdate = 0.0f;
+    return;
+  }
 
-    // Tightened caching logic for maximum performance
-    if (distSq < 0.25f && angleDiff < 0.05f) {
-      // Must continue updating if in mid-air to track landing prediction
-      if (!a_player->IsInMidair()) {
-        return;
-      }
+  if (frame.midair && _initialized) {
+    // [Mid-air Velocity Calculation]
+    // Calculate manual velocity from position delta for precise frame-by-frame
+    // prediction. Safety: If distance is too large (Teleport/FastTravel),
+    // fallback to zero or engine velocity to prevent RayCasting to infinity and
+    // crashing/lagging.
+    float distSq = currentPos.GetSquaredDistance(_lastUpdatePos);
+    if (distSq < 250000.0f) { // 500 units^2. Sanity check for teleport.
+      frame.vel = (currentPos - _lastUpdatePos) / _elapsedSinceUpdate;
+    } else {
+      // Teleport detected: Use engine velocity as fallback or zero
+      a_player->GetLinearVelocity(frame.vel);
+      if (SpatialProfiler::IsEnabled())
+        SpatialProfiler::GetSingleton()->AddFallback();
     }
   }
 
-  if (!IsFinite(currentPos)) {
+  // [Warm-up]
+  // After a reset, start a few tasks per frame in priority order so the
+  // first frame in a new cell does not cast every ray at once
+  ChannelMask channels = due;
+  if (_warmupTask < TASK_COUNT && _governor.IsIdle()) {
+    ChannelMask stage = 0;
+    for (std::uint32_t n = 0;
+         n < WARMUP_TASKS_PER_FRAME && _warmupTask < TASK_COUNT; ++n)
+      stage |= _governor.GetTask(_warmupTask++).channels;
+    channels &= stage;
+  }
+
+  // The pool runs the whole sweep at once, so it only applies when the
+  // governor is not time-slicing it
+  if (_pool.IsRunning() && !_governor.HasBudget()) {
+    SweepPooled(frame, channels);
+  } else {
+    SweepGoverned(frame, channels);
+  }
+
+  _lastUpdatePos = currentPos;
+  _elapsedSinceUpdate = 0.0f;
+  _initialized = true;
+}
+
+bool RaySenseLogic::AdvanceTick(float a_delta) {
+  if (_tickInterval <= 0.0f)
+    return true;
+
+  _tickAccumulator += a_delta;
+  if (_tickAccumulator < _tickInterval)
+    return false;
+
+  // Keep the phase, but never owe more than one tick after a hitch
+  _tickAccumulator = std::min(_tickAccumulator - _tickInterval, _tickInterval);
+  return true;
+}
+
+void RaySenseLogic::Extrapolate(const RE::NiPoint3 &a_pos,
+                                ChannelMask a_skip) {
+  Trace::Scope scope("Extrapolate");
+  const auto &base = _sweepFrame;
+  const RE::NiPoint3 moved = a_pos - base.pos;
+
+  // Displacement along the sampled movement direction (front rays) and the
+  // horizontal left axis of the sampled heading (side rays)
+  const RE::NiPoint3 &ahead = base.ahead;
+  const RE::NiPoint3 &forward = base.forward;
+  const float along = moved.x * ahead.x + moved.y * ahead.y;
+  const float leftward = -moved.x * forward.y + moved.y * forward.x;
+
+  SensorValues values = _sweepValues;
+
+  // Walls come closer as the player walks toward them. A ray that missed
+  // reported the full detect distance and stays a miss.
+  const float reach = _sweepScratch.detectDistance;
+  auto Approach = [&](Channel a_channel, float a_moved, float a_min) {
+    auto &value = values[ToIndex(a_channel)];
+    if (value < reach)
+      value = std::max(a_min, std::round(value - a_moved));
+  };
+  Approach(Channel::kWallFront, along, 0.0f);
+  Approach(Channel::kWallFrontL, along, 0.0f);
+  Approach(Channel::kWallFrontR, along, 0.0f);
+  Approach(Channel::kWallLeft, leftward, 0.0f);
+  Approach(Channel::kWallRight, -leftward, 0.0f);
+  // 0 means "no obstacle", so a detected one never extrapolates away
+  if (values[ToIndex(Channel::kObstacle)] > 0.0f)
+    Approach(Channel::kObstacle, along, 1.0f);
+
+  // Heights are measured from the player, so they follow vertical motion
+  constexpr Channel HEIGHTS[] = {Channel::kFront, Channel::kLeft,
+                                 Channel::kRight, Channel::kPlayerHeight};
+  for (auto channel : HEIGHTS) {
+    auto &value = values[ToIndex(channel)];
+    value = std::clamp(std::round(value + moved.z), 0.0f, CAP_HEIGHT);
+  }
+
+  // Obstacle types, landing, the array and surface hold until the next
+  // sample
+  Publish(values, SWEEP_CHANNELS & _profile.channels & ~_suppressed &
+                      ~a_skip & ~LANDING_CHANNELS &
+                      ~ToMask(Channel::kArrayNearest) &
+                      ~ToMask(Channel::kObstacleTypeFront) &
+                      ~ToMask(Channel::kObstacleTypeLeft) &
+                      ~ToMask(Channel::kObstacleTypeRight));
+}
+
+void RaySenseLogic::ApplyProfile(RE::Actor *a_actor) {
+  auto *profiles = SensorProfiles::GetSingleton();
+  const auto index = profiles->Select(a_actor);
+  if (index == _profileIndex)
     return;
+
+  _profileIndex = index;
+  _profile = profiles->Get(index);
+  profiles->AddSwitch(index);
+
+  const float tickHz = _profile.tickHz >= 0.0f
+                           ? _profile.tickHz
+                           : Settings::GetSingleton()->sensorTickHz;
+  _tickInterval = tickHz > 0.0f ? 1.0f / tickHz : 0.0f;
+
+  // Channels the profile turns off read as "nothing there"
+  const ChannelMask inactive = SWEEP_CHANNELS & ~_profile.channels;
+  constexpr Channel WALLS[] = {Channel::kWallFront, Channel::kWallFrontL,
+                               Channel::kWallFrontR, Channel::kWallLeft,
+                               Channel::kWallRight};
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    if (inactive & (1u << i))
+      _sweepValues[i] = 0.0f;
   }
+  for (auto wall : WALLS) {
+    if (inactive & ToMask(wall))
+      _sweepValues[ToIndex(wall)] = _profile.obstacleReach;
+  }
+  if (inactive & ToMask(Channel::kArrayNearest)) {
+    for (std::uint32_t i = 0; i < _array.GetCount(); ++i)
+      _arraySweep[i] = _array.GetElement(i).reach;
+  }
+  Publish(_sweepValues, inactive);
 
-  RE::NiPoint3 forward(0, 1, 0);
-  RE::NiPoint3 right(1, 0, 0);
-  RE::NiPoint3 left(-1, 0, 0);
+  SKSE::log::info("RaySenseLogic: Profile '{}'", _profile.name);
+}
 
-  if (auto root = a_player->Get3D()) {
-    const auto &m = root->world.rotate;
-    RE::NiPoint3 f = {m.entry[0][1], m.entry[1][1], m.entry[2][1]};
-    RE::NiPoint3 r = {m.entry[0][0], m.entry[1][0], m.entry[2][0]};
+ChannelMask RaySenseLogic::CollectDirty(RE::Actor *a_actor,
+                                        const SensorFrame &a_frame) {
+  // A new cell or worldspace invalidates everything, hit bodies included
+  auto *cell = a_actor->GetParentCell();
+  auto *worldspace = a_actor->GetWorldspace();
+  if (!_initialized || cell != _lastCell || worldspace != _lastWorldspace) {
+    _lastCell = cell;
+    _lastWorldspace = worldspace;
+    ClearHits(SWEEP_CHANNELS);
+    ClearSamples(SWEEP_CHANNELS);
+    _landMaterials.Clear();
+    ApplyProfile(a_actor);
+    return SWEEP_CHANNELS;
+  }
 
-    if (IsFinite(f) && IsFinite(r)) {
-      forward = f;
-      right = r;
-      left = right * -1.0f;
+  // Landing prediction follows every mid-air frame; the rest only resample
+  // once the player has moved
+  const ChannelMask always = a_frame.midair ? MIDAIR_CHANNELS : 0;
+
+  // Compared against the frame the current samples were taken from, so slow
+  // drift still adds up. Tightened thresholds for maximum performance.
+  const auto &base = _sweepFrame;
+  if (a_frame.pos.GetSquaredDistance(base.pos) >= 0.25f)
+    return SWEEP_CHANNELS;
+
+  ChannelMask dirty = 0;
+  // Wrapped, so turning through 0/2pi is a small turn rather than a full one
+  constexpr float TWO_PI = 2.0f * 3.1415926535f;
+  const float turned =
+      std::abs(std::remainder(a_frame.angle - base.angle, TWO_PI));
+  if (turned >= 0.05f) {
+    // Height above ground is cast straight down and ignores heading
+    dirty |= SWEEP_CHANNELS & ~ToMask(Channel::kPlayerHeight);
+  }
+
+  // Kept rays that hit a body which has since moved describe nothing now
+  const ChannelMask moved = CheckHitBodies(a_actor);
+  ClearSamples(moved);
+  return dirty | moved | always;
+}
+
+namespace {
+bool HasMoved(const RE::hkTransform &a_now, const RE::hkTransform &a_then,
+              float a_translationTolerance) {
+  constexpr float ROTATION_TOLERANCE = 0.001f;
+  const RE::hkVector4 *now[] = {&a_now.rotation.col0, &a_now.rotation.col1,
+                                &a_now.rotation.col2, &a_now.translation};
+  const RE::hkVector4 *then[] = {&a_then.rotation.col0, &a_then.rotation.col1,
+                                 &a_then.rotation.col2, &a_then.translation};
+  for (std::size_t v = 0; v < std::size(now); ++v) {
+    const float tolerance =
+        v == 3 ? a_translationTolerance : ROTATION_TOLERANCE;
+    for (int i = 0; i < 3; ++i) {
+      if (std::abs(now[v]->quad.m128_f32[i] - then[v]->quad.m128_f32[i]) >
+          tolerance)
+        return true;
     }
   }
+  return false;
+}
+} // namespace
 
-  // 1. Obstacle Detection
-  _obstacleVaultDist = UpdateObstacleDetection(a_player);
+ChannelMask RaySenseLogic::CheckHitBodies(RE::Actor *a_actor) {
+  Trace::Scope scope("CheckHitBodies");
+  auto *parentCell = a_actor->GetParentCell();
+  auto *bhkWorld_ = parentCell ? parentCell->GetbhkWorld() : nullptr;
+  if (!bhkWorld_)
+    return 0;
 
-  _obstacleTypeFront = UpdateObstacleType(a_player, forward);
-  _obstacleTypeLeft = UpdateObstacleType(a_player, left);
-  _obstacleTypeRight = UpdateObstacleType(a_player, right);
+  // One game unit, in Havok units
+  const float tolerance = RE::bhkWorld::GetWorldScale();
+  ChannelMask dirty = 0;
+
+  // Motion states are written by the physics step
+  RE::BSReadLockGuard lock(bhkWorld_->worldLock);
+  for (std::uint32_t i = 0; i < TASK_COUNT; ++i) {
+    auto &hits = _hits[i];
+    // No sweep is running, so pool threads are not recording
+    bool moved = hits.overflow;
+    for (std::uint32_t e = 0; e < hits.count && !moved; ++e) {
+      const auto &entry = hits.entries[e];
+      auto *body = entry.body.get();
+      // Removed from the world (door unloaded, cart despawned) counts too
+      moved = !body || !body->world ||
+              HasMoved(body->motion.motionState.transform, entry.transform,
+                       tolerance);
+    }
+    if (moved)
+      dirty |= _governor.GetTask(i).channels;
+  }
+  return dirty;
+}
 
-  if (_obstacleTypeFrontGlobal)
-    _obstacleTypeFrontGlobal->value =
-        static_cast<float>(_obstacleTypeFront.load());
-  if (_obstacleTypeLeftGlobal)
-    _obstacleTypeLeftGlobal->value =
-        static_cast<float>(_obstacleTypeLeft.load());
-  if (_obstacleTypeRightGlobal)
-    _obstacleTypeRightGlobal->value =
-        static_cast<float>(_obstacleTypeRight.load());
+void RaySenseLogic::ClearHits(ChannelMask a_channels) {
+  for (std::uint32_t i = 0; i < TASK_COUNT; ++i) {
+    if (_governor.GetTask(i).channels & a_channels)
+      _hits[i].Clear();
+  }
+}
 
-  // 2. Player Height Above Ground
-  _playerHeight = UpdateVerticality(_verticalityPlayerGlobal, a_player,
-                                    currentPos, RE::NiPoint3(0.0f, 0.0f, 0.0f),
-                                    RE::NiPoint3(0.0f, 0.0f, 0.0f), 0.0f, 0.0f);
+TemporalSampler *RaySenseLogic::GetSampler(RE::Actor *a_actor,
+                                           Channel a_channel) {
+  if (_jitterRadius <= 0.0f || !(SUPERSAMPLE_CHANNELS & ToMask(a_channel)) ||
+      !a_actor || !a_actor->IsPlayerRef())
+    return nullptr;
+  return &_samplers[ToIndex(a_channel)];
+}
+
+void RaySenseLogic::ClearSamples(ChannelMask a_channels) {
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    if (a_channels & (1u << i)) {
+      _samplers[i].Clear();
+      _roughness[i] = 0.0f;
+    }
+  }
+}
 
-  // Update Surface and Platform Info
-  UpdateSurfaceInfo(a_player);
+RE::NiPoint3 RaySenseLogic::GetWallJitter(TemporalSampler *a_sampler,
+                                          const RE::NiPoint3 &a_dir) {
+  if (!a_sampler)
+    return RE::NiPoint3(0.0f, 0.0f, 0.0f);
+  float u = 0.0f;
+  float v = 0.0f;
+  a_sampler->NextOffset(u, v);
+  return RE::NiPoint3(-a_dir.y * u * _jitterRadius,
+                      a_dir.x * u * _jitterRadius, v * _jitterRadius);
+}
 
-  // 3. Front Check
-  if (a_player->IsInMidair()) {
-    // [Mid-air Velocity Calculation]
-    // Calculate manual velocity from position delta for precise frame-by-frame
-    // prediction. Safety: If distance is too large (Teleport/FastTravel),
-    // fallback to zero or engine velocity to prevent RayCasting to infinity and
-    // crashing/lagging.
-    RE::NiPoint3 vel(0.0f, 0.0f, 0.0f);
-    if (_initialized) {
-      float distSq = currentPos.GetSquaredDistance(_lastUpdatePos);
-      if (distSq < 250000.0f) { // 500 units^2. Sanity check for teleport.
-        vel = (currentPos - _lastUpdatePos) / a_delta;
-      } else {
-        // Teleport detected: Use engine velocity as fallback or zero
-        a_player->GetLinearVelocity(vel);
-      }
+float RaySenseLogic::CombineWall(TemporalSampler &a_sampler, Channel a_channel,
+                                 const RE::NiPoint3 &a_origin,
+                                 const RE::NiPoint3 &a_dir, float a_min,
+                                 float a_reach) {
+  // [Motion Compensation]
+  // Kept rays are re-measured along the current ray, so walking toward a
+  // wall shortens old hits too. Hits off to the side of the current ray or
+  // behind a_min are dropped, and so are misses that ended off the ray or
+  // short of the current reach, as they say nothing about what is there.
+  const float reject = SUPERSAMPLE_REJECT * _jitterRadius;
+  auto Measure = [&](const TemporalSampler::Sample &a_sample,
+                     float &a_value) {
+    const RE::NiPoint3 offset(a_sample.point.x - a_origin.x,
+                              a_sample.point.y - a_origin.y,
+                              a_sample.point.z - a_origin.z);
+    const float along = offset.Dot(a_dir);
+    const RE::NiPoint3 across = offset - a_dir * along;
+    if (across.Dot(across) > reject * reject)
+      return false;
+    if (!a_sample.hit) {
+      a_value = a_reach;
+      return along >= a_reach - reject;
+    }
+    a_value = std::min(along, a_reach);
+    return along >= a_min;
+  };
+
+  float value = a_reach;
+  a_sampler.Combine(Measure, value, _roughness[ToIndex(a_channel)]);
+  return value;
+}
+
+float RaySenseLogic::GetRoughness(RE::Actor *a_actor, Channel a_channel) {
+  return GetSampler(a_actor, a_channel)
+             ? std::round(_roughness[ToIndex(a_channel)])
+             : 0.0f;
+}
+
+void RaySenseLogic::HitList::Clear() {
+  std::lock_guard guard(lock);
+  for (std::uint32_t e = 0; e < count; ++e)
+    entries[e].body.reset();
+  count = 0;
+  overflow = false;
+}
+
+void RaySenseLogic::HitList::Record(const RE::hkpCollidable *a_collidable) {
+  auto *body = a_collidable ? RE::hkpGetRigidBody(a_collidable) : nullptr;
+  // Static geometry never invalidates anything
+  if (!body || body->motion.type == RE::hkpMotion::MotionType::kFixed)
+    return;
+
+  std::lock_guard guard(lock);
+  for (std::uint32_t e = 0; e < count; ++e) {
+    if (entries[e].body.get() == body)
+      return;
+  }
+  if (count == CAPACITY) {
+    overflow = true;
+    return;
+  }
+  entries[count].body = body;
+  entries[count].transform = body->motion.motionState.transform;
+  ++count;
+}
+
+void RaySenseLogic::SweepGoverned(const SensorFrame &a_frame,
+                                  ChannelMask a_channels) {
+  // Landing prediction follows the newest position every frame and ignores
+  // the budget; on the ground both are ordinary tasks.
+  constexpr auto FRONT = static_cast<std::uint32_t>(SensorTask::kFront);
+  constexpr auto HEIGHT = static_cast<std::uint32_t>(SensorTask::kPlayerHeight);
+  constexpr auto LANDING = static_cast<std::uint32_t>(SensorTask::kLanding);
+  _governor.GetTask(FRONT).critical = a_frame.midair;
+  _governor.GetTask(HEIGHT).critical = a_frame.midair;
+  _governor.GetTask(LANDING).critical = a_frame.midair;
+
+  if (_governor.IsIdle()) {
+    if (KeepsSweepFrame(a_frame, a_channels))
+      _sweepFrame = a_frame;
+    ClearHits(a_channels);
+    _governor.BeginSweep(a_channels);
+  } else if (a_frame.midair) {
+    for (auto task : {FRONT, HEIGHT, LANDING}) {
+      const auto channels = _governor.GetTask(task).channels;
+      if (!(channels & _profile.channels))
+        continue;
+      ClearHits(channels);
+      _governor.Restart(task);
     }
+  }
 
-    _frontDiff =
-        UpdateVerticality(_verticalityFrontGlobal, a_player, currentPos,
-                          RE::NiPoint3(0.0f, 0.0f, 0.0f), vel, 0.5f, 7.0f);
-  } else {
-    // Grounded: Check 80 units ahead
-    _frontDiff = UpdateVerticality(_verticalityFrontGlobal, a_player,
-                                   currentPos, forward * 80.0f,
-                                   RE::NiPoint3(0.0f, 0.0f, 0.0f), 0.0f, 7.0f);
+  _governor.Run(
+      [&](std::uint32_t a_index, const SensorGovernor::Task &a_task) {
+        return StepTask(static_cast<SensorTask>(a_index), a_task.step,
+                        a_task.critical ? a_frame : _sweepFrame, _sweepScratch,
+                        _sweepValues);
+      },
+      [&](std::uint32_t, const SensorGovernor::Task &a_task) {
+        const ChannelMask done = a_task.channels & ~_suppressed;
+        _dirty &= ~done;
+        Publish(_sweepValues, done);
+      });
+}
+
+void RaySenseLogic::SweepPooled(const SensorFrame &a_frame,
+                                ChannelMask a_channels) {
+  Trace::Scope scope("SweepPooled");
+  if (KeepsSweepFrame(a_frame, a_channels))
+    _sweepFrame = a_frame;
+
+  // Longest job first (see SensorPool). Every job writes its own channels of
+  // _sweepValues, and the obstacle and array jobs their own _sweepScratch
+  // fields. tools/raysense-bench/pool.cpp replays this table.
+  constexpr SensorTask JOBS[] = {
+      SensorTask::kArray,        SensorTask::kObstacle,
+      SensorTask::kLanding,      SensorTask::kFront,
+      SensorTask::kPlayerHeight, SensorTask::kLeft,
+      SensorTask::kRight,        SensorTask::kObstacleType,
+      SensorTask::kObstacleType, SensorTask::kObstacleType};
+  constexpr std::uint32_t FIRST_TYPE_JOB = 7;
+  constexpr auto JOB_COUNT = static_cast<std::uint32_t>(std::size(JOBS));
+
+  // Dispatch only jobs whose task writes a requested channel
+  std::uint32_t jobs[JOB_COUNT];
+  std::uint32_t jobCount = 0;
+  ChannelMask channels = 0;
+  for (std::uint32_t i = 0; i < JOB_COUNT; ++i) {
+    const auto mask =
+        JOBS[i] == SensorTask::kObstacleType
+            ? ToMask(OBSTACLE_TYPE_CHANNELS[i - FIRST_TYPE_JOB])
+            : _governor.GetTask(static_cast<std::uint32_t>(JOBS[i])).channels;
+    if (mask & a_channels) {
+      jobs[jobCount++] = i;
+      channels |= mask;
+    }
   }
+  ClearHits(channels);
+
+  _pool.Run(jobCount, [&](std::uint32_t a_index) {
+    const auto job = jobs[a_index];
+    if (JOBS[job] == SensorTask::kObstacleType) {
+      // One obstacle type direction per job
+      StepTask(SensorTask::kObstacleType, job - FIRST_TYPE_JOB, a_frame,
+               _sweepScratch, _sweepValues);
+      return;
+    }
+    for (std::uint32_t step = 0; step != SensorGovernor::DONE;)
+      step = StepTask(JOBS[job], step, a_frame, _sweepScratch, _sweepValues);
+  });
 
-  // 4. Left/Right Check (50 units sideways)
-  _leftDiff = UpdateVerticality(_verticalityLeftGlobal, a_player, currentPos,
-                                left * 50.0f, RE::NiPoint3(0.0f, 0.0f, 0.0f),
-                                0.0f, 5.0f);
-  _rightDiff = UpdateVerticality(_verticalityRightGlobal, a_player, currentPos,
-                                 right * 50.0f, RE::NiPoint3(0.0f, 0.0f, 0.0f),
-                                 0.0f, 5.0f);
+  channels &= ~_suppressed;
+  _dirty &= ~channels;
+  Publish(_sweepValues, channels);
+}
 
-  _lastUpdatePos = currentPos;
-  _lastUpdateAngle = currentAngle;
-  _initialized = true;
+void RaySenseLogic::SenseActor(RE::Actor *a_actor, SensorValues &a_values) {
+  Trace::Scope scope("SenseActor");
+  a_values = {};
+  if (!a_actor || !a_actor->Is3DLoaded() || a_actor->IsDead())
+    return;
+
+  std::scoped_lock senseLock(_senseLock);
+
+  if (!IsFinite(a_actor->GetPosition()))
+    return;
+
+  // Same passes as the player, minus the stationary skip: the cache TTL
+  // already decides when an actor is sensed again.
+  UpdateWaterInfo(a_actor, a_values);
+  UpdateSurfaceInfo(a_actor, a_actor->GetPosition(), a_values);
+
+  if (auto *state = a_actor->AsActorState()) {
+    if (a_actor->IsOnMount() || state->IsSwimming())
+      return;
+  }
+
+  SensorFrame frame;
+  BuildFrame(a_actor, frame);
+  if (frame.midair) {
+    // No previous position is kept per actor, so use engine velocity
+    a_actor->GetLinearVelocity(frame.vel);
+    FindWater(a_actor, frame);
+  }
+
+  // ActorSensorCache already limits how many actors run per frame, so every
+  // task runs to completion here.
+  TaskScratch scratch;
+  for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(SensorTask::kTotal);
+       ++i) {
+    for (std::uint32_t step = 0; step != SensorGovernor::DONE;)
+      step = StepTask(static_cast<SensorTask>(i), step, frame, scratch,
+                      a_values);
+  }
 }
 
-float RaySenseLogic::UpdateObstacleDetection(RE::PlayerCharacter *a_player) {
-  if (!a_player)
-    return 0.0f;
+bool RaySenseLogic::Resample(RE::Actor *a_actor, ChannelMask a_channels) {
+  Trace::Scope scope("Resample");
+  if (!a_actor || !a_actor->Is3DLoaded() || a_actor->IsDead() ||
+      !IsFinite(a_actor->GetPosition()))
+    return false;
 
-  RE::NiPoint3 pos = a_player->GetPosition();
-  if (!IsFinite(pos))
-    return 0.0f;
+  // The player's sensing state belongs to the main thread
+  if (a_actor->IsPlayerRef()) {
+    _resampleRequested.fetch_or(a_channels, std::memory_order_relaxed);
+    return true;
+  }
 
-  RE::NiPoint3 forward(0, 1, 0);
-  if (auto root = a_player->Get3D()) {
-    const auto &m = root->world.rotate;
-    RE::NiPoint3 f = {m.entry[0][1], m.entry[1][1], m.entry[2][1]};
-    if (IsFinite(f)) {
-      forward = f;
+  std::scoped_lock senseLock(_senseLock);
+  const ChannelMask channels = a_channels & SWEEP_CHANNELS & _profile.channels;
+  // Water and surface are one pass each that writes all of their channels,
+  // as in SenseActor
+  const ChannelMask surface =
+      (a_channels & SURFACE_CHANNELS) ? SURFACE_CHANNELS : 0;
+  if (!channels && !surface)
+    return true;
+
+  SensorValues values{};
+  if (surface) {
+    UpdateWaterInfo(a_actor, values);
+    UpdateSurfaceInfo(a_actor, a_actor->GetPosition(), values);
+  }
+
+  SensorFrame frame;
+  if (channels) {
+    BuildFrame(a_actor, frame);
+    if (frame.midair) {
+      a_actor->GetLinearVelocity(frame.vel);
+      FindWater(a_actor, frame);
     }
   }
 
-  bool isSprinting = a_player->AsActorState()->IsSprinting();
-  float detectDistance = isSprinting ? 330.0f : 230.0f;
+  // Only tasks writing a requested channel run, each to completion. Other
+  // actors keep no per-task state, so this touches nothing the player's
+  // sensing uses.
+  TaskScratch scratch;
+  for (std::uint32_t i = 0; i < TASK_COUNT; ++i) {
+    if (!(_governor.GetTask(i).channels & channels))
+      continue;
+    for (std::uint32_t step = 0; step != SensorGovernor::DONE;)
+      step = StepTask(static_cast<SensorTask>(i), step, frame, scratch, values);
+  }
+  return ActorSensorCache::GetSingleton()->StoreValues(a_actor, values,
+                                                       channels | surface);
+}
+
+void RaySenseLogic::ResamplePlayer(RE::PlayerCharacter *a_player,
+                                   ChannelMask a_channels) {
+  Trace::Scope scope("ResamplePlayer");
+  const ChannelMask channels = a_channels & SWEEP_CHANNELS & _profile.channels;
+
+  SensorFrame frame;
+  BuildFrame(a_player, frame);
+  if (frame.midair) {
+    a_player->GetLinearVelocity(frame.vel);
+    FindWater(a_player, frame);
+  }
+
+  // Only tasks writing a requested channel run, each to completion
+  SensorValues values = _sweepValues;
+  TaskScratch scratch;
+  for (std::uint32_t i = 0; i < TASK_COUNT; ++i) {
+    if (!(_governor.GetTask(i).channels & channels))
+      continue;
+    for (std::uint32_t step = 0; step != SensorGovernor::DONE;)
+      step = StepTask(static_cast<SensorTask>(i), step, frame, scratch, values);
+  }
+
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    if (channels & ToMask(static_cast<Channel>(i)))
+      _sweepValues[i] = values[i];
+  }
+  Publish(values, channels);
+}
+
+std::uint32_t RaySenseLogic::StepTask(SensorTask a_task, std::uint32_t a_step,
+                                      const SensorFrame &a_frame,
+                                      TaskScratch &a_scratch,
+                                      SensorValues &a_values) {
+  const RE::NiPoint3 zero(0.0f, 0.0f, 0.0f);
+
+  // Player rays record the moving bodies they hit for this task
+  struct RecordScope {
+    explicit RecordScope(HitList *a_hits) { _recordHits = a_hits; }
+    ~RecordScope() { _recordHits = nullptr; }
+  } record(a_frame.actor && a_frame.actor->IsPlayerRef()
+               ? &_hits[static_cast<std::size_t>(a_task)]
+               : nullptr);
+
+  switch (a_task) {
+  case SensorTask::kFront:
+    if (a_frame.midair) {
+      a_values[ToIndex(Channel::kFront)] =
+          UpdateVerticality(a_frame.actor, Channel::kFront, a_frame.pos, zero,
+                            a_frame.vel, 0.5f, 7.0f);
+    } else {
+      // Grounded: Check ahead along the movement direction
+      a_values[ToIndex(Channel::kFront)] = UpdateVerticality(
+          a_frame.actor, Channel::kFront, a_frame.pos,
+          a_frame.ahead * GetFrontOffset(a_frame), zero, 0.0f, 7.0f);
+    }
+    a_values[ToIndex(Channel::kFrontRoughness)] =
+        GetRoughness(a_frame.actor, Channel::kFront);
+    return SensorGovernor::DONE;
+
+  case SensorTask::kPlayerHeight:
+    // [Controller Fusion]
+    // Still supported by the body the last ray confirmed: on the ground
+    if (a_frame.actor->IsPlayerRef()) {
+      const void *support = GetStableSupport(a_frame.actor);
+      const bool stable = support && support == _heightSupport;
+      _heightSupport = support;
+      if (stable) {
+        a_values[ToIndex(Channel::kPlayerHeight)] = 0.0f;
+        _raysAvoided.fetch_add(1, std::memory_order_relaxed);
+        return SensorGovernor::DONE;
+      }
+    }
+
+    // Height Above Ground
+    a_values[ToIndex(Channel::kPlayerHeight)] =
+        UpdateVerticality(a_frame.actor, Channel::kPlayerHeight, a_frame.pos,
+                          zero, zero, 0.0f, 0.0f);
+    return SensorGovernor::DONE;
+
+  case SensorTask::kObstacle:
+    return StepObstacleDetection(a_step, a_frame, a_scratch, a_values);
+
+  // Left/Right Check (50 units sideways)
+  case SensorTask::kLeft:
+    a_values[ToIndex(Channel::kLeft)] =
+        UpdateVerticality(a_frame.actor, Channel::kLeft, a_frame.pos,
+                          a_frame.left * 50.0f, zero, 0.0f, 5.0f);
+    return SensorGovernor::DONE;
+  case SensorTask::kRight:
+    a_values[ToIndex(Channel::kRight)] =
+        UpdateVerticality(a_frame.actor, Channel::kRight, a_frame.pos,
+                          a_frame.right * 50.0f, zero, 0.0f, 5.0f);
+    return SensorGovernor::DONE;
+
+  case SensorTask::kLanding:
+    return StepLanding(a_step, a_frame, a_values);
+
+  case SensorTask::kArray:
+    return StepArray(a_step, a_frame, a_scratch, a_values);
+
+  case SensorTask::kObstacleType: {
+    // One direction per step: front, left, right
+    const auto &CHANNELS = OBSTACLE_TYPE_CHANNELS;
+    const RE::NiPoint3 *directions[] = {&a_frame.forward, &a_frame.left,
+                                        &a_frame.right};
+    if (a_step >= std::size(CHANNELS))
+      return SensorGovernor::DONE;
+    if (IsActive(CHANNELS[a_step])) {
+      const auto formType = UpdateObstacleType(
+          a_frame.actor, *directions[a_step], CHANNELS[a_step]);
+      a_values[ToIndex(CHANNELS[a_step])] = static_cast<float>(formType);
+    }
+    return a_step + 1 < std::size(CHANNELS) ? a_step + 1
+                                            : SensorGovernor::DONE;
+  }
+
+  default:
+    return SensorGovernor::DONE;
+  }
+}
+
+std::uint32_t RaySenseLogic::StepObstacleDetection(std::uint32_t a_step,
+                                                   const SensorFrame &a_frame,
+                                                   TaskScratch &a_scratch,
+                                                   SensorValues &a_values) {
+  Trace::Scope scope("UpdateObstacleDetection");
+  RE::Actor *actor = a_frame.actor;
+  const RE::NiPoint3 &pos = a_frame.pos;
+  // Front rays follow the movement direction, side rays the facing
+  const RE::NiPoint3 &forward = a_frame.ahead;
+  const RE::NiPoint3 &facing = a_frame.forward;
+  if (!actor || !IsFinite(pos))
+    return SensorGovernor::DONE;
+
+  if (a_step == 0) {
+    auto *actorState = actor->AsActorState();
+    bool isSprinting = actorState && actorState->IsSprinting();
+    a_scratch.detectDistance = GetObstacleReach(a_frame, isSprinting);
+  }
+  const float detectDistance = a_scratch.detectDistance;
 
+  // Floor-like hits do not count as walls, and are kept as misses.
+  // Supersampled channels report the median of their kept rays instead.
   auto CastHorizontalRay = [&](const RE::NiPoint3 &a_dir, float a_height,
-                               float &a_dist) -> bool {
-    RE::NiPoint3 rayStart = pos;
-    rayStart.z += a_height;
+                               Channel a_channel, float &a_dist) -> bool {
+    RE::NiPoint3 nominal = pos;
+    nominal.z += a_height;
+    auto *sampler = GetSampler(actor, a_channel);
+    const RE::NiPoint3 rayStart = nominal + GetWallJitter(sampler, a_dir);
     RE::NiPoint3 rayEnd = rayStart + (a_dir * detectDistance);
 
     RE::hkpWorldRayCastOutput rayOutput;
-    if (PerformRayCast(a_player, rayStart, rayEnd, rayOutput)) {
-      if (rayOutput.normal.quad.m128_f32[2] > 0.5f) {
-        return false;
-      }
+    bool hit = PerformRayCast(actor, rayStart, rayEnd, rayOutput) &&
+               rayOutput.normal.quad.m128_f32[2] <= 0.5f;
+    RecordHit(actor, a_channel, rayStart, rayEnd, hit ? &rayOutput : nullptr);
+    if (hit)
       a_dist = rayOutput.hitFraction * detectDistance;
-      return true;
+
+    if (sampler) {
+      const RE::NiPoint3 point = hit ? rayStart + a_dir * a_dist : rayEnd;
+      sampler->Push({ToPoint(rayStart), ToPoint(point), hit});
+      a_dist = CombineWall(*sampler, a_channel, nominal, a_dir, 0.0f,
+                           detectDistance);
+      hit = a_dist < detectDistance;
     }
-    return false;
+    return hit;
   };
 
-  // Front Detection
-  float kneeDistFront = 0.0f, dummyDist = 0.0f;
-  bool kneeHitFront = CastHorizontalRay(forward, 40.0f, kneeDistFront);
-  bool chestHitFront = CastHorizontalRay(forward, 120.0f, dummyDist);
-
-  _wallFrontDist = kneeHitFront ? std::round(kneeDistFront) : detectDistance;
-  _obstacleVaultDist =
-      (kneeHitFront && !chestHitFront) ? _wallFrontDist.load() : 0.0f;
-
-  if (_wallFrontGlobal)
-    _wallFrontGlobal->value = _wallFrontDist.load();
-  if (_verticalityObstacleGlobal)
-    _verticalityObstacleGlobal->value = _obstacleVaultDist.load();
+  auto CastOffsetFrontRay = [&](const RE::NiPoint3 &a_offset,
+                                Channel a_channel, float &a_dist) -> bool {
+    RE::NiPoint3 nominal = pos + a_offset - (forward * 50.0f);
+    nominal.z += 40.0f; // Knee height
+    auto *sampler = GetSampler(actor, a_channel);
+    const RE::NiPoint3 rayStart = nominal + GetWallJitter(sampler, forward);
+    float totalReach = detectDistance + 50.0f;
+    RE::NiPoint3 rayEnd = rayStart + (forward * totalReach);
 
-  // Front Left/Right (Offset) Detection - Only if center hit
-  if (kneeHitFront) {
-    RE::NiPoint3 rightVec(0, 1, 0);
-    if (auto root = a_player->Get3D()) {
-      auto &m = root->world.rotate;
-      rightVec = {m.entry[0][0], m.entry[1][0], m.entry[2][0]};
+    RE::hkpWorldRayCastOutput rayOutput;
+    bool hit = PerformRayCast(actor, rayStart, rayEnd, rayOutput) &&
+               rayOutput.normal.quad.m128_f32[2] <= 0.5f;
+    RecordHit(actor, a_channel, rayStart, rayEnd, hit ? &rayOutput : nullptr);
+    if (hit)
+      a_dist = (rayOutput.hitFraction * totalReach) - 50.0f;
+
+    if (sampler) {
+      // Distances count from 50 units into the ray, as above
+      const RE::NiPoint3 origin = nominal + forward * 50.0f;
+      const RE::NiPoint3 point =
+          hit ? rayStart + forward * (a_dist + 50.0f) : rayEnd;
+      sampler->Push({ToPoint(rayStart), ToPoint(point), hit});
+      a_dist = CombineWall(*sampler, a_channel, origin, forward, -50.0f,
+                           detectDistance);
+      hit = a_dist < detectDistance;
     }
+    return hit;
+  };
 
-    auto CastOffsetFrontRay = [&](const RE::NiPoint3 &a_offset,
-                                  float &a_dist) -> bool {
-      RE::NiPoint3 rayStart = pos + a_offset - (forward * 50.0f);
-      rayStart.z += 40.0f; // Knee height
-      float totalReach = detectDistance + 50.0f;
-      RE::NiPoint3 rayEnd = rayStart + (forward * totalReach);
-
-      RE::hkpWorldRayCastOutput rayOutput;
-      if (PerformRayCast(a_player, rayStart, rayEnd, rayOutput)) {
-        if (rayOutput.normal.quad.m128_f32[2] > 0.5f)
-          return false;
-        a_dist = (rayOutput.hitFraction * totalReach) - 50.0f;
-        return true;
-      }
-      return false;
-    };
+  switch (a_step) {
+  case 0:
+    // Front Detection: knee
+    a_scratch.kneeDist = 0.0f;
+    a_scratch.kneeHit = CastHorizontalRay(forward, 40.0f, Channel::kWallFront,
+                                          a_scratch.kneeDist);
+    return 1;
+
+  case 1: {
+    // Front Detection: chest
+    float dummyDist = 0.0f;
+    bool chestHitFront =
+        CastHorizontalRay(forward, 120.0f, Channel::kTotal, dummyDist);
+
+    float wallFrontDist = a_scratch.kneeHit ? std::round(a_scratch.kneeDist)
+                                            : detectDistance;
+    const bool obstacle = a_scratch.kneeHit && !chestHitFront;
+    a_values[ToIndex(Channel::kWallFront)] = wallFrontDist;
+    a_values[ToIndex(Channel::kWallRoughness)] =
+        GetRoughness(actor, Channel::kWallFront);
+    a_values[ToIndex(Channel::kObstacle)] = obstacle ? wallFrontDist : 0.0f;
+
+    // The obstacle is the knee hit, when the chest ray passed over it
+    if (actor->IsPlayerRef()) {
+      std::scoped_lock lock(_hitSampleLock);
+      auto &sample = _hitSamples[ToIndex(Channel::kObstacle)];
+      sample = _hitSamples[ToIndex(Channel::kWallFront)];
+      sample.valid = sample.valid && obstacle;
+    }
 
-    float distFrontL = 0.0f, distFrontR = 0.0f;
-    bool hitL = CastOffsetFrontRay(rightVec * -100.0f, distFrontL);
-    bool hitR = CastOffsetFrontRay(rightVec * 100.0f, distFrontR);
+    // Front Left/Right (Offset) Detection - Only if center hit
+    if (!a_scratch.kneeHit) {
+      a_values[ToIndex(Channel::kWallFrontL)] = detectDistance;
+      a_values[ToIndex(Channel::kWallFrontR)] = detectDistance;
+      return 4;
+    }
+    return 2;
+  }
 
-    _wallFrontLDist =
+  case 2: {
+    if (!IsActive(Channel::kWallFrontL))
+      return 3;
+    float distFrontL = 0.0f;
+    bool hitL = CastOffsetFrontRay(a_frame.aheadRight * -100.0f,
+                                   Channel::kWallFrontL, distFrontL);
+    a_values[ToIndex(Channel::kWallFrontL)] =
         hitL ? std::max(0.0f, std::round(distFrontL)) : detectDistance;
-    _wallFrontRDist =
-        hitR ? std::max(0.0f, std::round(distFrontR)) : detectDistance;
-  } else {
-    _wallFrontLDist = detectDistance;
-    _wallFrontRDist = detectDistance;
+    return 3;
   }
 
-  if (_wallFrontLGlobal)
-    _wallFrontLGlobal->value = _wallFrontLDist.load();
-  if (_wallFrontRGlobal)
-    _wallFrontRGlobal->value = _wallFrontRDist.load();
+  case 3: {
+    if (!IsActive(Channel::kWallFrontR))
+      return 4;
+    float distFrontR = 0.0f;
+    bool hitR = CastOffsetFrontRay(a_frame.aheadRight * 100.0f,
+                                   Channel::kWallFrontR, distFrontR);
+    a_values[ToIndex(Channel::kWallFrontR)] =
+        hitR ? std::max(0.0f, std::round(distFrontR)) : detectDistance;
+    return 4;
+  }
 
-  // Left Detection
-  float kneeDistLeft = 0.0f;
-  RE::NiPoint3 left(-forward.y, forward.x, 0.0f);
-  bool kneeHitLeft = CastHorizontalRay(left, 40.0f, kneeDistLeft);
-  _wallLeftDist = kneeHitLeft ? std::round(kneeDistLeft) : detectDistance;
-  if (_wallLeftGlobal)
-    _wallLeftGlobal->value = _wallLeftDist.load();
+  case 4: {
+    // Left Detection
+    if (!IsActive(Channel::kWallLeft))
+      return 5;
+    float kneeDistLeft = 0.0f;
+    RE::NiPoint3 left(-facing.y, facing.x, 0.0f);
+    bool kneeHitLeft =
+        CastHorizontalRay(left, 40.0f, Channel::kWallLeft, kneeDistLeft);
+    a_values[ToIndex(Channel::kWallLeft)] =
+        kneeHitLeft ? std::round(kneeDistLeft) : detectDistance;
+    return 5;
+  }
 
-  // Right Detection
-  float kneeDistRight = 0.0f;
-  RE::NiPoint3 right(forward.y, -forward.x, 0.0f);
-  bool kneeHitRight = CastHorizontalRay(right, 40.0f, kneeDistRight);
-  _wallRightDist = kneeHitRight ? std::round(kneeDistRight) : detectDistance;
-  if (_wallRightGlobal)
-    _wallRightGlobal->value = _wallRightDist.load();
+  case 5: {
+    // Right Detection
+    if (!IsActive(Channel::kWallRight))
+      return SensorGovernor::DONE;
+    float kneeDistRight = 0.0f;
+    RE::NiPoint3 right(facing.y, -facing.x, 0.0f);
+    bool kneeHitRight =
+        CastHorizontalRay(right, 40.0f, Channel::kWallRight, kneeDistRight);
+    a_values[ToIndex(Channel::kWallRight)] =
+        kneeHitRight ? std::round(kneeDistRight) : detectDistance;
+    return SensorGovernor::DONE;
+  }
 
-  return _obstacleVaultDist;
+  default:
+    return SensorGovernor::DONE;
+  }
 }
 
 std::uint32_t
-RaySenseLogic::UpdateObstacleType(RE::PlayerCharacter *a_player,
-                                  const RE::NiPoint3 &a_direction) {
-  if (!a_player || !IsFinite(a_direction))
+RaySenseLogic::UpdateObstacleType(RE::Actor *a_actor,
+                                  const RE::NiPoint3 &a_direction,
+                                  Channel a_channel) {
+  Trace::Scope scope("UpdateObstacleType");
+  if (!a_actor || !IsFinite(a_direction))
     return 0;
 
-  float detectDistance = 250.0f;
-  RE::NiPoint3 rayStart = a_player->GetPosition();
+  float detectDistance = _profile.typeReach;
+  RE::NiPoint3 rayStart = a_actor->GetPosition();
   if (!IsFinite(rayStart))
     return 0;
 
@@ -332,30 +1252,169 @@ RaySenseLogic::UpdateObstacleType(RE::PlayerCharacter *a_player,
   RE::NiPoint3 rayEnd = rayStart + (a_direction * detectDistance);
 
   RE::hkpWorldRayCastOutput rayOutput;
-  if (PerformRayCast(a_player, rayStart, rayEnd, rayOutput)) {
-    if (rayOutput.rootCollidable) {
-      auto *ref =
-          RE::TESHavokUtilities::FindCollidableRef(*rayOutput.rootCollidable);
-      if (ref) {
-        auto *base = ref->GetBaseObject();
-        if (base) {
-          return static_cast<std::uint32_t>(base->GetFormType());
-        }
-      }
-    }
+  if (PerformRayCast(a_actor, rayStart, rayEnd, rayOutput)) {
+    RecordHit(a_actor, a_channel, rayStart, rayEnd, &rayOutput);
+    const auto info =
+        CollidableCache::GetSingleton()->Classify(rayOutput.rootCollidable);
+    return static_cast<std::uint32_t>(info.formType);
   }
+  RecordHit(a_actor, a_channel, rayStart, rayEnd, nullptr);
   return 0; // kNone
 }
 
+std::uint32_t RaySenseLogic::StepArray(std::uint32_t a_step,
+                                       const SensorFrame &a_frame,
+                                       TaskScratch &a_scratch,
+                                       SensorValues &a_values) {
+  Trace::Scope scope("StepArray");
+  auto &nearest = a_values[ToIndex(Channel::kArrayNearest)];
+  RE::Actor *actor = a_frame.actor;
+  // Other actors have nowhere to keep per-element values
+  if (!_array.IsEnabled() || !actor || !actor->IsPlayerRef() ||
+      !IsFinite(a_frame.pos)) {
+    nearest = 0.0f;
+    return SensorGovernor::DONE;
+  }
+
+  if (a_step == 0) {
+    const auto &pos = a_frame.pos;
+    const auto &forward = a_frame.forward;
+    const auto &right = a_frame.right;
+    _array.Generate({pos.x, pos.y, pos.z}, {forward.x, forward.y, forward.z},
+                    {right.x, right.y, right.z}, RE::bhkWorld::GetWorldScale(),
+                    a_scratch.arrayFrom.data(), a_scratch.arrayTo.data());
+    a_scratch.arrayNearest = _array.GetMaxReach();
+  }
+  if (a_step >= _array.GetCount())
+    return SensorGovernor::DONE;
+
+  // Floor-like hits do not count, as for the wall rays
+  const float reach = _array.GetElement(a_step).reach;
+  RE::hkVector4 from;
+  RE::hkVector4 to;
+  from.quad = a_scratch.arrayFrom[a_step];
+  to.quad = a_scratch.arrayTo[a_step];
+  RE::hkpWorldRayCastOutput rayOutput;
+  float distance = reach;
+  if (PerformHavokRayCast(actor, from, to, rayOutput) &&
+      rayOutput.normal.quad.m128_f32[2] <= 0.5f)
+    distance = std::round(rayOutput.hitFraction * reach);
+  a_scratch.arrayValues[a_step] = distance;
+  a_scratch.arrayNearest = std::min(a_scratch.arrayNearest, distance);
+
+  if (a_step + 1 < _array.GetCount())
+    return a_step + 1;
+  // Complete: published with ArrayNearest, unless that is held
+  std::copy_n(a_scratch.arrayValues.begin(), _array.GetCount(),
+              _arraySweep.begin());
+  nearest = a_scratch.arrayNearest;
+  return SensorGovernor::DONE;
+}
+
+std::uint32_t RaySenseLogic::StepLanding(std::uint32_t a_step,
+                                         const SensorFrame &a_frame,
+                                         SensorValues &a_values) {
+  Trace::Scope scope("StepLanding");
+  auto &time = a_values[ToIndex(Channel::kLandingTime)];
+  auto &height = a_values[ToIndex(Channel::kLandingHeight)];
+  auto &surface = a_values[ToIndex(Channel::kLandingSurface)];
+
+  RE::Actor *actor = a_frame.actor;
+  const RE::NiPoint3 &pos = a_frame.pos;
+  const RE::NiPoint3 &vel = a_frame.vel;
+  if (!a_frame.midair || !actor || !IsFinite(pos) || !IsFinite(vel)) {
+    time = height = surface = 0.0f; // Landed
+    return SensorGovernor::DONE;
+  }
+
+  // [Ballistic Arc]
+  // p(t) = pos + vel * t - g * t^2 / 2, followed until it has dropped the
+  // profile's drop length or MAX_LANDING_TIME has passed. The arc is cut
+  // into chords of roughly _landingSegmentLength, so a slow hop casts one
+  // ray and a long fall at most _landingSegments.
+  const float gravity = GRAVITY / RE::bhkWorld::GetWorldScale();
+  const float drop = _profile.dropLength;
+  const float horizon = std::min(
+      MAX_LANDING_TIME,
+      (vel.z + std::sqrt(vel.z * vel.z + 2.0f * gravity * drop)) / gravity);
+  const RE::NiPoint3 endVel(vel.x, vel.y, vel.z - gravity * horizon);
+  const float arcLength = 0.5f * (vel.Length() + endVel.Length()) * horizon;
+  const auto segments = std::clamp<std::uint32_t>(
+      static_cast<std::uint32_t>(std::ceil(arcLength / _landingSegmentLength)),
+      1, _landingSegments);
+
+  if (a_step == 0) {
+    time = NO_LANDING_MS;
+    height = CAP_HEIGHT;
+    surface = 0.0f;
+  }
+  if (a_step >= segments)
+    return SensorGovernor::DONE;
+
+  auto At = [&](float a_time) {
+    RE::NiPoint3 point = pos + vel * a_time;
+    point.z -= 0.5f * gravity * a_time * a_time;
+    return point;
+  };
+  const float t0 = horizon * a_step / segments;
+  const float t1 = horizon * (a_step + 1) / segments;
+  const RE::NiPoint3 start = At(t0);
+  const RE::NiPoint3 end = At(t1);
+
+  RE::hkpWorldRayCastOutput rayOutput;
+  const bool hit = PerformRayCast(actor, start, end, rayOutput);
+  float fraction = hit ? rayOutput.hitFraction : 1.0f;
+
+  // Water the chord crosses before any hit is the landing surface
+  bool water = false;
+  const float level = a_frame.waterHeight;
+  if (a_frame.hasWater && start.z >= level && end.z < level) {
+    const float crossing = (start.z - level) / (start.z - end.z);
+    if (crossing < fraction) {
+      fraction = crossing;
+      water = true;
+    }
+  }
+
+  if (!hit && !water) {
+    RecordHit(actor, Channel::kLandingHeight, start, end, nullptr);
+    return a_step + 1 < segments ? a_step + 1 : SensorGovernor::DONE;
+  }
+
+  const RE::NiPoint3 landing = start + (end - start) * fraction;
+  time = std::round((t0 + (t1 - t0) * fraction) * 1000.0f);
+  height = std::clamp(std::round(pos.z - landing.z), -CAP_HEIGHT, CAP_HEIGHT);
+
+  SurfaceType type = SurfaceType::kWater;
+  if (water) {
+    // The water plane has no collidable to align to
+    RecordHit(actor, Channel::kLandingHeight, start, end, nullptr);
+  } else {
+    RecordHit(actor, Channel::kLandingHeight, start, end, &rayOutput);
+    const auto info =
+        CollidableCache::GetSingleton()->Classify(rayOutput.rootCollidable);
+    const bool terrain = info.layer == RE::COL_LAYER::kTerrain ||
+                         info.layer == RE::COL_LAYER::kGround;
+    type = GetSurfaceType(
+        terrain ? _landMaterials.Lookup(landing).dominant : info.material,
+        info.layer);
+  }
+  surface = static_cast<float>(type);
+  return SensorGovernor::DONE;
+}
+
 bool RaySenseLogic::IsObstacleDetected() const {
-  return _obstacleVaultDist.load() > 0.0f;
+  return GetValue(Channel::kObstacle) > 0.0f;
 }
 
-float RaySenseLogic::UpdateVerticality(
-    RE::TESGlobal *a_global, RE::PlayerCharacter *a_player,
-    const RE::NiPoint3 &a_pos, const RE::NiPoint3 &a_offset,
-    const RE::NiPoint3 &a_vel, float a_predictionTime, float a_slantAngle) {
-  if (!a_player)
+float RaySenseLogic::UpdateVerticality(RE::Actor *a_actor, Channel a_channel,
+                                       const RE::NiPoint3 &a_pos,
+                                       const RE::NiPoint3 &a_offset,
+                                       const RE::NiPoint3 &a_vel,
+                                       float a_predictionTime,
+                                       float a_slantAngle) {
+  Trace::Scope scope("UpdateVerticality");
+  if (!a_actor)
     return 0.0f;
 
   if (!IsFinite(a_pos) || !IsFinite(a_offset) || !IsFinite(a_vel) ||
@@ -366,7 +1425,18 @@ float RaySenseLogic::UpdateVerticality(
   RE::NiPoint3 rayStart = a_pos + a_offset + (a_vel * a_predictionTime);
   rayStart.z += 100.0f;
 
-  float totalDepth = CAP_HEIGHT + 1000.0f;
+  // [Supersample] One ray per frame, jittered around the nominal one
+  const RE::NiPoint3 nominal = rayStart;
+  auto *sampler = GetSampler(a_actor, a_channel);
+  if (sampler) {
+    float u = 0.0f;
+    float v = 0.0f;
+    sampler->NextOffset(u, v);
+    rayStart.x += u * _jitterRadius;
+    rayStart.y += v * _jitterRadius;
+  }
+
+  float totalDepth = _profile.dropLength;
   RE::NiPoint3 rayEnd = rayStart;
   rayEnd.z -= totalDepth;
 
@@ -391,10 +1461,12 @@ float RaySenseLogic::UpdateVerticality(
   RE::hkpWorldRayCastOutput rayOutput;
   float terrainHeight = a_pos.z - CAP_HEIGHT; // Default to "far below"
 
-  if (PerformRayCast(a_player, rayStart, rayEnd, rayOutput)) {
+  const bool hit = PerformRayCast(a_actor, rayStart, rayEnd, rayOutput);
+  if (hit) {
     terrainHeight =
         rayStart.z + (rayEnd.z - rayStart.z) * rayOutput.hitFraction;
   }
+  RecordHit(a_actor, a_channel, rayStart, rayEnd, hit ? &rayOutput : nullptr);
 
   float diff = std::round(a_pos.z - terrainHeight);
 
@@ -407,68 +1479,148 @@ float RaySenseLogic::UpdateVerticality(
     diff = rayOutput.HasHit() ? 0.0f : CAP_HEIGHT;
   }
 
+  if (sampler) {
+    const RE::NiPoint3 point =
+        hit ? rayStart + (rayEnd - rayStart) * rayOutput.hitFraction : rayEnd;
+    sampler->Push({ToPoint(rayStart), ToPoint(point), hit});
+
+    // [Motion Compensation]
+    // Kept hits are re-measured from the current height. Rays that started
+    // outside the current ray's footprint are dropped.
+    const float reject = SUPERSAMPLE_REJECT * _jitterRadius;
+    auto Measure = [&](const TemporalSampler::Sample &a_sample,
+                       float &a_value) {
+      const float dx = a_sample.start.x - nominal.x;
+      const float dy = a_sample.start.y - nominal.y;
+      if (dx * dx + dy * dy > reject * reject)
+        return false;
+      a_value = CAP_HEIGHT;
+      if (a_sample.hit) {
+        a_value = std::clamp(std::round(a_pos.z - a_sample.point.z), 0.0f,
+                             CAP_HEIGHT);
+      }
+      return true;
+    };
+    if (sampler->Combine(Measure, diff, _roughness[ToIndex(a_channel)]))
+      diff = std::round(diff);
+  }
+
   if (rayOutput.HasHit() && a_predictionTime == 0.0f &&
       a_offset.Length() < 0.1f) {
     // Terrain normal analysis was here, removed as part of Slope-to-Surface
     // update
   }
 
-  if (a_global) {
-    a_global->value = diff;
-  }
   return diff;
 }
 
+// [Core Helper: CastRayLocked]
+// Every Havok query goes through here so lock waits are measured in one
+// place.
+void RaySenseLogic::CastRayLocked(RE::bhkWorld *a_bhkWorld,
+                                  RE::hkpWorld *a_hkpWorld,
+                                  const RE::hkpWorldRayCastInput &a_input,
+                                  RE::hkpWorldRayCastOutput &a_output) {
+  const bool traceEnabled = Trace::IsEnabled();
+  const bool spatialEnabled = SpatialProfiler::IsEnabled();
+
+  // CRITICAL THREAD SAFETY: Havok Engine is multi-threaded.
+  // We MUST acquire a read lock before casting rays.
+  const auto lockStart = (traceEnabled || spatialEnabled) ? Trace::Now() : 0;
+  RE::BSReadLockGuard lock(a_bhkWorld->worldLock);
+  if (lockStart) {
+    const auto lockEnd = Trace::Now();
+    if (traceEnabled)
+      Trace::GetSingleton()->Record("LockWait", lockStart, lockEnd);
+    if (spatialEnabled)
+      SpatialProfiler::GetSingleton()->AddRay(lockEnd - lockStart);
+  }
+
+  Trace::Scope scope("CastRay");
+  a_hkpWorld->CastRay(a_input, a_output);
+  _rayCount.fetch_add(1, std::memory_order_relaxed);
+
+  // Still under the world lock, so the body's motion state is consistent
+  if (_recordHits && a_output.HasHit())
+    _recordHits->Record(a_output.rootCollidable);
+}
+
+void RaySenseLogic::RecordHit(RE::Actor *a_actor, Channel a_channel,
+                              const RE::NiPoint3 &a_start,
+                              const RE::NiPoint3 &a_end,
+                              const RE::hkpWorldRayCastOutput *a_output) {
+  if (a_channel == Channel::kTotal || !a_actor || !a_actor->IsPlayerRef())
+    return;
+
+  HitSample sample;
+  if (a_output && a_output->HasHit()) {
+    const auto &normal = a_output->normal.quad.m128_f32;
+    sample.point = a_start + (a_end - a_start) * a_output->hitFraction;
+    sample.normal = RE::NiPoint3(normal[0], normal[1], normal[2]);
+    if (a_output->rootCollidable) {
+      sample.ref =
+          CollidableCache::GetSingleton()->Classify(a_output->rootCollidable)
+              .ref;
+    }
+    sample.valid = true;
+  }
+
+  std::scoped_lock lock(_hitSampleLock);
+  _hitSamples[ToIndex(a_channel)] = sample;
+}
+
 // [Core Helper: PerformRayCast]
 // Centralizes all Havok interaction to ensure safety and consistent settings.
-bool RaySenseLogic::PerformRayCast(RE::PlayerCharacter *a_player,
+bool RaySenseLogic::PerformRayCast(RE::Actor *a_actor,
                                    const RE::NiPoint3 &a_start,
                                    const RE::NiPoint3 &a_end,
                                    RE::hkpWorldRayCastOutput &a_output) {
   if (!IsFinite(a_start) || !IsFinite(a_end))
     return false;
 
-  auto *parentCell = a_player->GetParentCell();
-  if (!parentCell)
-    return false;
-
-  auto *bhkWorld_ = parentCell->GetbhkWorld();
-  if (!bhkWorld_)
-    return false;
+  float scale = RE::bhkWorld::GetWorldScale();
+  return PerformHavokRayCast(
+      a_actor,
+      RE::hkVector4(a_start.x * scale, a_start.y * scale, a_start.z * scale,
+                    0.0f),
+      RE::hkVector4(a_end.x * scale, a_end.y * scale, a_end.z * scale, 0.0f),
+      a_output);
+}
 
-  auto *hkpWorld_ = bhkWorld_->GetWorld1();
-  if (!hkpWorld_)
+bool RaySenseLogic::PerformHavokRayCast(RE::Actor *a_actor,
+                                        const RE::hkVector4 &a_from,
+                                        const RE::hkVector4 &a_to,
+                                        RE::hkpWorldRayCastOutput &a_output) {
+  auto *parentCell = a_actor->GetParentCell();
+  auto *bhkWorld_ = parentCell ? parentCell->GetbhkWorld() : nullptr;
+  auto *hkpWorld_ = bhkWorld_ ? bhkWorld_->GetWorld1() : nullptr;
+  if (!hkpWorld_) {
+    if (SpatialProfiler::IsEnabled())
+      SpatialProfiler::GetSingleton()->AddFallback();
     return false;
+  }
 
-  float scale = RE::bhkWorld::GetWorldScale();
   RE::hkpWorldRayCastInput rayInput;
-  rayInput.from = RE::hkVector4(a_start.x * scale, a_start.y * scale,
-                                a_start.z * scale, 0.0f);
-  rayInput.to =
-      RE::hkVector4(a_end.x * scale, a_end.y * scale, a_end.z * scale, 0.0f);
+  rayInput.from = a_from;
+  rayInput.to = a_to;
 
   std::uint32_t filter = 0;
-  a_player->GetCollisionFilterInfo(filter);
+  a_actor->GetCollisionFilterInfo(filter);
   rayInput.filterInfo = filter;
 
-  // CRITICAL THREAD SAFETY: Havok Engine is multi-threaded.
-  // We MUST acquire a read lock before casting rays.
-  {
-    RE::BSReadLockGuard lock(bhkWorld_->worldLock);
-    hkpWorld_->CastRay(rayInput, a_output);
-  }
+  CastRayLocked(bhkWorld_, hkpWorld_, rayInput, a_output);
 
   return a_output.HasHit();
 }
 
-bool RaySenseLogic::PerformWaterRayCast(RE::PlayerCharacter *a_player,
+bool RaySenseLogic::PerformWaterRayCast(RE::Actor *a_actor,
                                         const RE::NiPoint3 &a_start,
                                         const RE::NiPoint3 &a_end,
                                         RE::hkpWorldRayCastOutput &a_output) {
   if (!IsFinite(a_start) || !IsFinite(a_end))
     return false;
 
-  auto *parentCell = a_player->GetParentCell();
+  auto *parentCell = a_actor->GetParentCell();
   if (!parentCell)
     return false;
 
@@ -487,17 +1639,12 @@ bool RaySenseLogic::PerformWaterRayCast(RE::PlayerCharacter *a_player,
   rayInput.to =
       RE::hkVector4(a_end.x * scale, a_end.y * scale, a_end.z * scale, 0.0f);
 
-  // Ignore player using collision filter
+  // Ignore the caster using collision filter
   std::uint32_t filter = 0;
-  a_player->GetCollisionFilterInfo(filter);
+  a_actor->GetCollisionFilterInfo(filter);
   rayInput.filterInfo = filter;
 
-  // CRITICAL THREAD SAFETY: Havok Engine is multi-threaded.
-  // We MUST acquire a read lock before casting rays.
-  {
-    RE::BSReadLockGuard lock(bhkWorld_->worldLock);
-    hkpWorld_->CastRay(rayInput, a_output);
-  }
+  CastRayLocked(bhkWorld_, hkpWorld_, rayInput, a_output);
 
   if (a_output.HasHit() && a_output.rootCollidable) {
     if (a_output.rootCollidable->GetCollisionLayer() == RE::COL_LAYER::kWater) {
@@ -507,19 +1654,192 @@ bool RaySenseLogic::PerformWaterRayCast(RE::PlayerCharacter *a_player,
   return false;
 }
 
-void RaySenseLogic::UpdateSurfaceInfo(RE::PlayerCharacter *a_player) {
-  if (!a_player)
+bool RaySenseLogic::TakeSurfaceSample(RE::PlayerCharacter *a_player,
+                                      bool a_force, RE::NiPoint3 &a_origin) {
+  a_origin = a_player->GetPosition();
+  if (!FootstepEvents::IsEnabled() || a_force)
+    return true;
+
+  // [Footstep Sampling]
+  // The surface only matters where a foot comes down; the timer keeps
+  // standing, sliding and riding platforms up to date between steps.
+  auto *footsteps = FootstepEvents::GetSingleton();
+  footsteps->Attach(a_player);
+  const auto foot = footsteps->Consume();
+  if (foot == FootstepEvents::Foot::kNone &&
+      _surfaceElapsed < _surfaceInterval)
+    return false;
+  _surfaceElapsed = 0.0f;
+
+  static const RE::BSFixedString LEFT_FOOT{"NPC L Foot [Lft ]"};
+  static const RE::BSFixedString RIGHT_FOOT{"NPC R Foot [Rft ]"};
+  const RE::BSFixedString *node = nullptr;
+  if (foot == FootstepEvents::Foot::kLeft)
+    node = &LEFT_FOOT;
+  else if (foot == FootstepEvents::Foot::kRight)
+    node = &RIGHT_FOOT;
+  if (auto *root = node ? a_player->Get3D() : nullptr) {
+    if (auto *object = root->GetObjectByName(*node)) {
+      const auto &translate = object->world.translate;
+      if (IsFinite(translate)) {
+        a_origin.x = translate.x;
+        a_origin.y = translate.y;
+      }
+    }
+  }
+  return true;
+}
+
+void RaySenseLogic::UpdateWaterInfo(RE::Actor *a_actor,
+                                    SensorValues &a_values) {
+  Trace::Scope scope("UpdateWaterInfo");
+  auto &depth = a_values[ToIndex(Channel::kWaterDepth)];
+  auto &ahead = a_values[ToIndex(Channel::kWaterAhead)];
+  auto &shore = a_values[ToIndex(Channel::kShoreDistance)];
+  depth = ahead = shore = 0.0f;
+  if (!a_actor)
+    return;
+
+  const RE::NiPoint3 pos = a_actor->GetPosition();
+  auto *cell = a_actor->GetParentCell();
+  if (!IsFinite(pos) || !cell)
+    return;
+
+  // Water surface over the feet: the cell's plane, or a volume found by ray
+  auto *water = WaterCache::GetSingleton();
+  bool hasWater = false;
+  float surface = 0.0f;
+  WaterCache::Plane plane;
+  if (water->GetPlane(cell, pos, plane)) {
+    surface = plane.height;
+    hasWater = true;
+  }
+  if (water->HasVolumes(cell)) {
+    RE::NiPoint3 rayStart = pos;
+    rayStart.z += WATER_PROBE_UP;
+    RE::hkpWorldRayCastOutput rayOutput;
+    if (PerformWaterRayCast(a_actor, rayStart, pos, rayOutput)) {
+      const float volume =
+          rayStart.z + (pos.z - rayStart.z) * rayOutput.hitFraction;
+      surface = hasWater ? std::max(surface, volume) : volume;
+      hasWater = true;
+    }
+  }
+  if (!hasWater)
+    return;
+
+  depth = std::clamp(std::round(surface - pos.z), 0.0f, CAP_HEIGHT);
+
+  // Terrain under the water ahead and toward the shore, interiors have none
+  auto *tes = RE::TES::GetSingleton();
+  RE::NiPoint3 forward, right;
+  GetHeading(a_actor, forward, right);
+  if (!tes)
+    return;
+
+  if (IsActive(Channel::kWaterAhead)) {
+    RE::NiPoint3 point = pos + forward * _profile.obstacleReach;
+    float ground = pos.z;
+    tes->GetLandHeight(point, ground);
+    ahead = std::clamp(std::round(surface - ground), 0.0f, CAP_HEIGHT);
+  }
+
+  if (IsActive(Channel::kShoreDistance) && depth > 0.0f) {
+    shore = SHORE_RANGE;
+    for (float dist = SHORE_STEP; dist <= SHORE_RANGE; dist += SHORE_STEP) {
+      float ground = 0.0f;
+      if (!tes->GetLandHeight(pos + forward * dist, ground)) {
+        shore = 0.0f; // No land data to march over
+        break;
+      }
+      if (ground >= surface) {
+        shore = dist;
+        break;
+      }
+    }
+  }
+}
+
+RaySenseLogic::SurfaceType
+RaySenseLogic::GetSurfaceType(RE::MATERIAL_ID a_material,
+                              RE::COL_LAYER a_layer) {
+  switch (a_material) {
+  case RE::MATERIAL_ID::kGrass:
+  case static_cast<RE::MATERIAL_ID>(3):
+    return SurfaceType::kGrass;
+  case RE::MATERIAL_ID::kSnow:
+  case RE::MATERIAL_ID::kSnowStairs:
+  case static_cast<RE::MATERIAL_ID>(5):
+    return SurfaceType::kSnow;
+  case RE::MATERIAL_ID::kWater:
+  case RE::MATERIAL_ID::kWaterPuddle:
+  case static_cast<RE::MATERIAL_ID>(4):
+    return SurfaceType::kWater;
+  case RE::MATERIAL_ID::kWood:
+  case RE::MATERIAL_ID::kWoodLight:
+  case RE::MATERIAL_ID::kWoodHeavy:
+  case RE::MATERIAL_ID::kWoodStairs:
+  case RE::MATERIAL_ID::kWoodAsStairs:
+  case RE::MATERIAL_ID::kBarrel:
+  case RE::MATERIAL_ID::kBasket:
+  case RE::MATERIAL_ID::kCarriageWheel:
+  case static_cast<RE::MATERIAL_ID>(7):
+  case static_cast<RE::MATERIAL_ID>(17):
+  case static_cast<RE::MATERIAL_ID>(18):
+    return SurfaceType::kWood;
+  case RE::MATERIAL_ID::kStone:
+  case RE::MATERIAL_ID::kStoneBroken:
+  case RE::MATERIAL_ID::kStoneStairs:
+  case RE::MATERIAL_ID::kStoneHeavy:
+  case RE::MATERIAL_ID::kStoneAsStairs:
+  case RE::MATERIAL_ID::kStoneStairsBroken:
+  case RE::MATERIAL_ID::kBoulderSmall:
+  case RE::MATERIAL_ID::kBoulderMedium:
+  case RE::MATERIAL_ID::kBoulderLarge:
+  case static_cast<RE::MATERIAL_ID>(1):
+  case static_cast<RE::MATERIAL_ID>(13):
+    return SurfaceType::kStone;
+  case RE::MATERIAL_ID::kDirt:
+  case RE::MATERIAL_ID::kMud:
+  case static_cast<RE::MATERIAL_ID>(2):
+  case static_cast<RE::MATERIAL_ID>(11):
+    return SurfaceType::kDirt;
+  case RE::MATERIAL_ID::kSand:
+  case static_cast<RE::MATERIAL_ID>(12):
+    return SurfaceType::kSand;
+  case RE::MATERIAL_ID::kGravel:
+  case static_cast<RE::MATERIAL_ID>(14):
+    return SurfaceType::kGravel;
+  default:
+    break;
+  }
+
+  // Layer-based fallback (Wood/Props)
+  if (a_layer == RE::COL_LAYER::kTrees || a_layer == RE::COL_LAYER::kProps)
+    return SurfaceType::kWood;
+  return SurfaceType::kDefault;
+}
+
+void RaySenseLogic::UpdateSurfaceInfo(RE::Actor *a_actor,
+                                      const RE::NiPoint3 &a_origin,
+                                      SensorValues &a_values) {
+  Trace::Scope scope("UpdateSurfaceInfo");
+  if (!a_actor)
     return;
 
+  // Debug output only describes the player
+  const bool isPlayer = a_actor->IsPlayerRef();
+
   SurfaceType surfaceType = SurfaceType::kDefault;
   PlatformType platformType = PlatformType::kNone;
 
-  RE::NiPoint3 pos = a_player->GetPosition();
+  RE::NiPoint3 pos = a_origin;
   RE::MATERIAL_ID mID = RE::MATERIAL_ID::kNone;
   RE::COL_LAYER layer = RE::COL_LAYER::kUnidentified;
+  bool onActor = false;
 
   // 1. 최우선 순위: IsSwimming() 확인
-  if (auto *actorState = a_player->AsActorState()) {
+  if (auto *actorState = a_actor->AsActorState()) {
     if (actorState->IsSwimming()) {
       surfaceType = SurfaceType::kWater;
       goto FinishUpdate;
@@ -528,37 +1848,52 @@ void RaySenseLogic::UpdateSurfaceInfo(RE::PlayerCharacter *a_player) {
 
   // 2. Precise Material Detection (Standard Raycast)
   {
-    RE::NiPoint3 rayStart = pos;
-    rayStart.z += 20.0f; // Lowered from 50 to avoid self-collision
-    RE::NiPoint3 rayEnd = pos;
-    rayEnd.z -= 40.0f;
-
-    RE::hkpWorldRayCastOutput rayOutput;
-    bool hit = PerformRayCast(a_player, rayStart, rayEnd, rayOutput);
+    // Capture Sound Material from Controller (Splash/Footstep detect)
+    RE::MATERIAL_ID soundMID = RE::MATERIAL_ID::kNone;
+    if (auto *charController = a_actor->GetCharController()) {
+      soundMID =
+          *SKSE::stl::adjust_pointer<RE::MATERIAL_ID>(charController, 0x304);
+    }
 
-    if (hit && rayOutput.rootCollidable) {
-      layer = rayOutput.rootCollidable->GetCollisionLayer();
+    // [Controller Fusion]
+    // While the controller stands on the same body and reports the same
+    // footstep material, the ray would find the same material again.
+    const void *support = isPlayer ? GetStableSupport(a_actor) : nullptr;
+    if (support && _surfaceCache.support == support &&
+        _surfaceCache.soundMID == soundMID) {
+      mID = _surfaceCache.rayMID;
+      layer = _surfaceCache.layer;
+      onActor = _surfaceCache.onActor;
+      _raysAvoided.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      RE::NiPoint3 rayStart = pos;
+      rayStart.z += 20.0f; // Lowered from 50 to avoid self-collision
+      RE::NiPoint3 rayEnd = pos;
+      rayEnd.z -= 40.0f;
 
-      if (layer == RE::COL_LAYER::kTerrain || layer == RE::COL_LAYER::kGround) {
-        if (auto *tes = RE::TES::GetSingleton()) {
+      RE::hkpWorldRayCastOutput rayOutput;
+      bool hit = PerformRayCast(a_actor, rayStart, rayEnd, rayOutput);
+      RecordHit(a_actor, Channel::kSurface, rayStart, rayEnd,
+                hit ? &rayOutput : nullptr);
+
+      if (hit && rayOutput.rootCollidable) {
+        const auto info =
+            CollidableCache::GetSingleton()->Classify(rayOutput.rootCollidable);
+        layer = info.layer;
+        onActor = info.isActor;
+
+        if (layer == RE::COL_LAYER::kTerrain ||
+            layer == RE::COL_LAYER::kGround) {
           RE::NiPoint3 hitPos =
               rayStart + (rayEnd - rayStart) * rayOutput.hitFraction;
-          mID = tes->GetLandMaterialType(hitPos);
-        }
-      } else {
-        if (auto *hkShape = rayOutput.rootCollidable->GetShape()) {
-          if (auto *bhkShape = hkShape->userData) {
-            mID = bhkShape->materialID;
-          }
+          mID = _landMaterials.Lookup(hitPos).dominant;
+        } else {
+          mID = info.material;
         }
       }
-    }
 
-    // Capture Sound Material from Controller (Splash/Footstep detect)
-    RE::MATERIAL_ID soundMID = RE::MATERIAL_ID::kNone;
-    if (auto *charController = a_player->GetCharController()) {
-      soundMID =
-          *SKSE::stl::adjust_pointer<RE::MATERIAL_ID>(charController, 0x304);
+      if (isPlayer)
+        _surfaceCache = {support, soundMID, mID, layer, onActor};
     }
 
     // Capture Raycast Material
@@ -567,7 +1902,7 @@ void RaySenseLogic::UpdateSurfaceInfo(RE::PlayerCharacter *a_player) {
     // Log for debugging
     static RE::MATERIAL_ID lastSoundMID = RE::MATERIAL_ID::kNone;
     static RE::MATERIAL_ID lastRayMID = RE::MATERIAL_ID::kNone;
-    if (soundMID != lastSoundMID || raycastMID != lastRayMID) {
+    if (isPlayer && (soundMID != lastSoundMID || raycastMID != lastRayMID)) {
       SKSE::log::info("DEBUG | RayMID: {} | SoundMID: {} | Layer: {}",
                       static_cast<std::uint32_t>(raycastMID),
                       static_cast<std::uint32_t>(soundMID),
@@ -577,9 +1912,9 @@ void RaySenseLogic::UpdateSurfaceInfo(RE::PlayerCharacter *a_player) {
     }
 
     // Debug: Export raw values
-    if (_rawMaterialIDGlobal)
+    if (isPlayer && _rawMaterialIDGlobal)
       _rawMaterialIDGlobal->value = static_cast<float>(raycastMID);
-    if (_rawLayerIDGlobal)
+    if (isPlayer && _rawLayerIDGlobal)
       _rawLayerIDGlobal->value = static_cast<float>(soundMID);
 
     // 1. WATER FORCE CHECK (Splash Sound Material)
@@ -601,95 +1936,29 @@ void RaySenseLogic::UpdateSurfaceInfo(RE::PlayerCharacter *a_player) {
       goto FinishUpdate;
     }
 
-    // 3. WATER SUBMERSION CHECK (using GetSubmergedLevel)
+    // 3. WATER SUBMERSION CHECK (depth from UpdateWaterInfo)
     {
-      static REL::Relocation<float (*)(RE::Actor *, float, RE::TESObjectCELL *)>
-          GetSubmergedLevel{REL::RelocationID(36452, 37448)};
-
-      if (GetSubmergedLevel.address()) {
-        float waterLevel =
-            GetSubmergedLevel(a_player, pos.z, a_player->GetParentCell());
-        if (waterLevel > 0.05f) { // If Submerged Level > 0.05, the player is
-                                  // wading in water.
-          surfaceType = SurfaceType::kWater;
-          if (_rawLayerIDGlobal)
-            _rawLayerIDGlobal->value = waterLevel; // Log submerged level
-          goto FinishUpdate;
-        }
+      const float depth = a_values[ToIndex(Channel::kWaterDepth)];
+      // Wading once 5% of the actor's height is under water
+      if (depth > a_actor->GetHeight() * 0.05f) {
+        surfaceType = SurfaceType::kWater;
+        if (isPlayer && _rawLayerIDGlobal)
+          _rawLayerIDGlobal->value = depth; // Log water depth
+        goto FinishUpdate;
       }
     }
 
     // 4. GENERAL MATERIAL MAPPING
     RE::MATERIAL_ID finalMID =
         (raycastMID != RE::MATERIAL_ID::kNone) ? raycastMID : soundMID;
-    switch (finalMID) {
-    case RE::MATERIAL_ID::kGrass:
-    case static_cast<RE::MATERIAL_ID>(3):
-      surfaceType = SurfaceType::kGrass;
-      break;
-    case RE::MATERIAL_ID::kSnow:
-    case RE::MATERIAL_ID::kSnowStairs:
-    case static_cast<RE::MATERIAL_ID>(5):
-      surfaceType = SurfaceType::kSnow;
-      break;
-    case RE::MATERIAL_ID::kWater:
-    case RE::MATERIAL_ID::kWaterPuddle:
-    case static_cast<RE::MATERIAL_ID>(4):
-      surfaceType = SurfaceType::kWater;
-      goto FinishUpdate;
-    case RE::MATERIAL_ID::kWood:
-    case RE::MATERIAL_ID::kWoodLight:
-    case RE::MATERIAL_ID::kWoodHeavy:
-    case RE::MATERIAL_ID::kWoodStairs:
-    case RE::MATERIAL_ID::kWoodAsStairs:
-    case RE::MATERIAL_ID::kBarrel:
-    case RE::MATERIAL_ID::kBasket:
-    case RE::MATERIAL_ID::kCarriageWheel:
-    case static_cast<RE::MATERIAL_ID>(7):
-    case static_cast<RE::MATERIAL_ID>(17):
-    case static_cast<RE::MATERIAL_ID>(18):
-      surfaceType = SurfaceType::kWood;
-      break;
-    case RE::MATERIAL_ID::kStone:
-    case RE::MATERIAL_ID::kStoneBroken:
-    case RE::MATERIAL_ID::kStoneStairs:
-    case RE::MATERIAL_ID::kStoneHeavy:
-    case RE::MATERIAL_ID::kStoneAsStairs:
-    case RE::MATERIAL_ID::kStoneStairsBroken:
-    case RE::MATERIAL_ID::kBoulderSmall:
-    case RE::MATERIAL_ID::kBoulderMedium:
-    case RE::MATERIAL_ID::kBoulderLarge:
-    case static_cast<RE::MATERIAL_ID>(1):
-    case static_cast<RE::MATERIAL_ID>(13):
-      surfaceType = SurfaceType::kStone;
-      break;
-    case RE::MATERIAL_ID::kDirt:
-    case RE::MATERIAL_ID::kMud:
-    case static_cast<RE::MATERIAL_ID>(2):
-    case static_cast<RE::MATERIAL_ID>(11):
-      surfaceType = SurfaceType::kDirt;
-      break;
-    case RE::MATERIAL_ID::kSand:
-    case static_cast<RE::MATERIAL_ID>(12):
-      surfaceType = SurfaceType::kSand;
-      break;
-    case RE::MATERIAL_ID::kGravel:
-    case static_cast<RE::MATERIAL_ID>(14):
-      surfaceType = SurfaceType::kGravel;
-      break;
-    }
-
-    // 5. LAYER-BASED FALLBACK (Wood/Props)
-    if (surfaceType == SurfaceType::kDefault) {
-      if (layer == RE::COL_LAYER::kTrees || layer == RE::COL_LAYER::kProps) {
-        surfaceType = SurfaceType::kWood;
-      }
-    }
+    surfaceType = GetSurfaceType(finalMID, layer);
   }
 
 FinishUpdate:
-  // 5. Platform Type (Velocity-based)
-  if (auto *charController = a_player->GetCharController()) {
+  // 5. Platform Type (standing on an actor, else velocity-based)
+  if (onActor) {
+    platformType = PlatformType::kActor;
+  } else if (auto *charController = a_actor->GetCharController()) {
     auto &surfaceInfo = charController->surfaceInfo;
     RE::NiPoint3 surfaceVel = {surfaceInfo.surfaceVelocity.quad.m128_f32[0],
                                surfaceInfo.surfaceVelocity.quad.m128_f32[1],
@@ -700,11 +1969,6 @@ FinishUpdate:
     }
   }
 
-  _surfaceType = static_cast<float>(surfaceType);
-  _platformType = static_cast<float>(platformType);
-
-  if (_surfaceTypeGlobal)
-    _surfaceTypeGlobal->value = _surfaceType.load();
-  if (_platformTypeGlobal)
-    _platformTypeGlobal->value = _platformType.load();
+  a_values[ToIndex(Channel::kSurface)] = static_cast<float>(surfaceType);
+  a_values[ToIndex(Channel::kPlatform)] = static_cast<float>(platformType);
 }
@@ -1,8 +1,18 @@
 #pragma once
 
+#include "LandMaterialCache.h"
 #include "PCH.h"
+#include "SensorArray.h"
+#include "SensorChannels.h"
+#include "SensorGovernor.h"
+#include "SensorPool.h"
+#include "SensorProfiles.h"
+#include "Settings.h"
+#include "TemporalSampler.h"
+#include <array>
 #include <atomic>
 #include <cmath>
+#include <mutex>
 
 class RaySenseLogic {
 public:
@@ -14,73 +24,279 @@ public:
   void Install();
   void OnUpdate(RE::PlayerCharacter *a_player, float a_delta);
   void OnJump(RE::PlayerCharacter *a_player);
+  // Drops every cached sample and re-warms the channels over a few frames
+  void Reset();
 
   bool IsObstacleDetected() const;
   float GetJumpBonus() const { return OBSTACLE_JUMP_BONUS; }
 
-  // Getters for OAR Conditions (All rounded values)
-  float GetFrontDiff() const {
-    return _frontDiff.load(std::memory_order_relaxed);
-  }
-  float GetLeftDiff() const {
-    return _leftDiff.load(std::memory_order_relaxed);
-  }
-  float GetRightDiff() const {
-    return _rightDiff.load(std::memory_order_relaxed);
-  }
-  float GetObstacleDist() const {
-    return _obstacleVaultDist.load(std::memory_order_relaxed);
-  }
-  float GetWallFrontDist() const {
-    return _wallFrontDist.load(std::memory_order_relaxed);
-  }
-  float GetWallFrontLDist() const {
-    return _wallFrontLDist.load(std::memory_order_relaxed);
-  }
-  float GetWallFrontRDist() const {
-    return _wallFrontRDist.load(std::memory_order_relaxed);
-  }
-  float GetWallLeftDist() const {
-    return _wallLeftDist.load(std::memory_order_relaxed);
-  }
-  float GetWallRightDist() const {
-    return _wallRightDist.load(std::memory_order_relaxed);
-  }
-  float GetPlayerHeight() const {
-    return _playerHeight.load(std::memory_order_relaxed);
-  }
-  float GetSurfaceType() const {
-    return _surfaceType.load(std::memory_order_relaxed);
-  }
-  float GetPlatformType() const {
-    return _platformType.load(std::memory_order_relaxed);
-  }
-  std::uint32_t GetObstacleTypeFront() const {
-    return _obstacleTypeFront.load(std::memory_order_relaxed);
-  }
-  std::uint32_t GetObstacleTypeLeft() const {
-    return _obstacleTypeLeft.load(std::memory_order_relaxed);
-  }
-  std::uint32_t GetObstacleTypeRight() const {
-    return _obstacleTypeRight.load(std::memory_order_relaxed);
+  using SensorValues = std::array<float, CHANNEL_COUNT>;
+
+  // Latest published player value (All rounded values)
+  float GetValue(Channel a_channel) const {
+    return _values[static_cast<std::size_t>(a_channel)].load(
+        std::memory_order_relaxed);
   }
 
+  // Value for any reference: the player reads the published values, other
+  // actors go through ActorSensorCache. False while no value exists yet.
+  bool GetChannelValue(RE::TESObjectREFR *a_refr, Channel a_channel,
+                       float &a_value) const;
+
+  // Runs every sensor pass for a non-player actor (main thread only).
+  void SenseActor(RE::Actor *a_actor, SensorValues &a_values);
+
+  // Any thread. For the player the channels are queued and sampled at the
+  // start of the next player update on the main thread, surface and water
+  // included, before conditions read them again. For other actors the sweep
+  // channels are cast right away on the calling thread, surface and water
+  // passes run when any of their channels is listed, and the values are
+  // published once a condition has read that actor.
+  bool Resample(RE::Actor *a_actor, ChannelMask a_channels);
+
+  // Where a channel's last player ray ended. Walls and obstacles only count
+  // hits they reported as such; a miss leaves valid unset.
+  struct HitSample {
+    RE::NiPoint3 point;
+    RE::NiPoint3 normal;
+    RE::FormID ref{0}; // 0 = terrain or no reference
+    bool valid{false};
+  };
+
+  // Any thread. Player only: other actors keep no hit data.
+  bool GetHit(RE::TESObjectREFR *a_refr, Channel a_channel,
+              HitSample &a_hit) const;
+
+  // Any thread. Distance along one [Array] ray for the player, its reach
+  // when clear; false for other actors and elements out of range.
+  bool GetArrayValue(RE::TESObjectREFR *a_refr, std::uint32_t a_direction,
+                     std::uint32_t a_height, float &a_value) const;
+
+  const SensorArray &GetSensorArray() const { return _array; }
+  const SensorGovernor &GetGovernor() const { return _governor; }
+  const LandMaterialCache &GetLandMaterials() const { return _landMaterials; }
+
 private:
   static constexpr float CAP_HEIGHT = 4000.0f;
+  static constexpr float SHORE_STEP = 128.0f;   // Land texel spacing
+  static constexpr float SHORE_RANGE = 2048.0f; // Reported when none found
+  static constexpr float WATER_PROBE_UP = 200.0f; // Volume ray start
+  static constexpr float GRAVITY = 9.81f; // m/s^2, scaled by the world scale
+  static constexpr float MAX_LANDING_TIME = 3.0f; // Arc horizon in seconds
+  static constexpr float NO_LANDING_MS = 10000.0f; // Nothing on the arc
+  // Slower movement does not say where the actor is heading
+  static constexpr float MIN_INTENT_SPEED = 20.0f;
+  static constexpr float FRONT_OFFSET = 80.0f; // Without [Lookahead]
+  // Faster is a teleport or a physics glitch, not something to predict
+  static constexpr float MAX_PREDICT_SPEED_SQ = 3000.0f * 3000.0f;
   static constexpr float OBSTACLE_JUMP_BONUS =
       80.0f; // Adjusted value for natural feel
 
-  float UpdateObstacleDetection(RE::PlayerCharacter *a_player);
-  std::uint32_t UpdateObstacleType(RE::PlayerCharacter *a_player,
-                                   const RE::NiPoint3 &a_direction);
-  float UpdateVerticality(RE::TESGlobal *a_global,
-                          RE::PlayerCharacter *a_player,
+  static constexpr ChannelMask SURFACE_CHANNELS =
+      ToMask(Channel::kSurface) | ToMask(Channel::kPlatform) |
+      ToMask(Channel::kWaterDepth) | ToMask(Channel::kWaterAhead) |
+      ToMask(Channel::kShoreDistance);
+  static constexpr Channel OBSTACLE_TYPE_CHANNELS[] = {
+      Channel::kObstacleTypeFront, Channel::kObstacleTypeLeft,
+      Channel::kObstacleTypeRight};
+  static constexpr ChannelMask LANDING_CHANNELS =
+      ToMask(Channel::kLandingTime) | ToMask(Channel::kLandingHeight) |
+      ToMask(Channel::kLandingSurface);
+  // Channels that keep the full rate in mid-air between ticks
+  static constexpr ChannelMask MIDAIR_CHANNELS =
+      LANDING_CHANNELS | ToMask(Channel::kFront) |
+      ToMask(Channel::kPlayerHeight);
+  // Ground and wall channels the player supersamples over several frames
+  static constexpr ChannelMask SUPERSAMPLE_CHANNELS =
+      ToMask(Channel::kFront) | ToMask(Channel::kLeft) |
+      ToMask(Channel::kRight) | ToMask(Channel::kWallFront) |
+      ToMask(Channel::kWallFrontL) | ToMask(Channel::kWallFrontR) |
+      ToMask(Channel::kWallLeft) | ToMask(Channel::kWallRight);
+  // Kept rays starting further than this many jitter radii off the current
+  // ray no longer describe what it sees
+  static constexpr float SUPERSAMPLE_REJECT = 2.0f;
+  // Channels written by the sweep tasks
+  static constexpr ChannelMask SWEEP_CHANNELS =
+      ALL_CHANNELS & ~SURFACE_CHANNELS;
+
+  // Inputs every pass reads, captured when a sweep starts
+  struct SensorFrame {
+    RE::Actor *actor{nullptr};
+    RE::NiPoint3 pos;
+    RE::NiPoint3 forward;
+    RE::NiPoint3 right;
+    RE::NiPoint3 left;
+    RE::NiPoint3 vel; // Mid-air only
+    // Movement direction on the ground (forward when standing or in the
+    // air) and its right axis; front sensors look along these
+    RE::NiPoint3 ahead;
+    RE::NiPoint3 aheadRight;
+    float speed{0.0f}; // Horizontal ground speed
+    float angle{0.0f}; // Heading (data.angle.z)
+    float waterHeight{0.0f}; // Cell water plane, valid with hasWater
+    bool hasWater{false};    // Only looked up on the main thread
+    bool midair{false};
+  };
+
+  // Sensor passes as governor tasks, highest priority first
+  enum class SensorTask : std::uint32_t {
+    kFront = 0,
+    kPlayerHeight,
+    kObstacle,
+    kLeft,
+    kRight,
+    kObstacleType,
+    kLanding,
+    kArray,
+
+    kTotal
+  };
+
+  static constexpr std::size_t TASK_COUNT =
+      static_cast<std::size_t>(SensorTask::kTotal);
+  // Tasks started per frame while warming up after a reset
+  static constexpr std::uint32_t WARMUP_TASKS_PER_FRAME = 2;
+
+  // Non-static bodies a task's rays hit, with their transform at that time.
+  // Filled from CastRayLocked (possibly on pool threads) while the world
+  // lock is held; checked on the main thread to invalidate the task.
+  struct HitList {
+    static constexpr std::size_t CAPACITY = 4;
+
+    struct Entry {
+      RE::hkRefPtr<RE::hkpRigidBody> body;
+      RE::hkTransform transform;
+    };
+
+    std::mutex lock;
+    std::array<Entry, CAPACITY> entries;
+    std::uint32_t count{0};
+    bool overflow{false}; // Too many bodies to track: always dirty
+
+    void Clear();
+    void Record(const RE::hkpCollidable *a_collidable);
+  };
+
+  // Task results carried between their steps
+  struct TaskScratch {
+    // Obstacle pass
+    float detectDistance{230.0f};
+    float kneeDist{0.0f};
+    bool kneeHit{false};
+    // Array pass: every ray, generated on its first step in Havok units
+    std::array<__m128, SensorArray::MAX_ELEMENTS> arrayFrom;
+    std::array<__m128, SensorArray::MAX_ELEMENTS> arrayTo;
+    std::array<float, SensorArray::MAX_ELEMENTS> arrayValues;
+    float arrayNearest{0.0f};
+  };
+
+  // Forward/right axes from the actor's root node (world Y/X as fallback)
+  static void GetHeading(RE::Actor *a_actor, RE::NiPoint3 &a_forward,
+                         RE::NiPoint3 &a_right);
+  static void BuildFrame(RE::Actor *a_actor, SensorFrame &a_frame);
+  // Fills the frame's water plane for landing prediction (any thread)
+  static void FindWater(RE::Actor *a_actor, SensorFrame &a_frame);
+  // Body the character controller stands on, or null unless it is on the
+  // ground and fully supported
+  static const void *GetStableSupport(RE::Actor *a_actor);
+
+  // Player sweep, either time-sliced by the governor or fanned out on the
+  // pool and published once every pass has joined
+  void SweepGoverned(const SensorFrame &a_frame, ChannelMask a_channels);
+  void SweepPooled(const SensorFrame &a_frame, ChannelMask a_channels);
+
+  // Switches to the profile for a_actor's surroundings (on cell change)
+  void ApplyProfile(RE::Actor *a_actor);
+  bool IsActive(Channel a_channel) const {
+    return (_profile.channels & ToMask(a_channel)) != 0;
+  }
+
+  // [Lookahead] Front drop offset and obstacle reach for the frame's speed;
+  // the built-in constants without a reaction time
+  float GetFrontOffset(const SensorFrame &a_frame) const;
+  float GetObstacleReach(const SensorFrame &a_frame, bool a_sprinting) const;
+
+  // Channels whose samples no longer match the player or world state
+  ChannelMask CollectDirty(RE::Actor *a_actor, const SensorFrame &a_frame);
+  // Channels of tasks whose hit bodies moved since they were sampled
+  ChannelMask CheckHitBodies(RE::Actor *a_actor);
+  void ClearHits(ChannelMask a_channels);
+
+  // True when a sensing tick is due (always, without a fixed rate)
+  bool AdvanceTick(float a_delta);
+  // Publishes the last sample adjusted for how far the player has moved,
+  // except a_skip
+  void Extrapolate(const RE::NiPoint3 &a_pos, ChannelMask a_skip = 0);
+  // False for a mid-air sweep of landing prediction alone: it casts from
+  // the live frame, and the held channels still extrapolate from the frame
+  // they were sampled at
+  static bool KeepsSweepFrame(const SensorFrame &a_frame,
+                              ChannelMask a_channels) {
+    return !a_frame.midair || (a_channels & ~MIDAIR_CHANNELS);
+  }
+
+  // Runs one step (at most one ray) of a task and returns the next step,
+  // or SensorGovernor::DONE once the task has written all its channels.
+  std::uint32_t StepTask(SensorTask a_task, std::uint32_t a_step,
+                         const SensorFrame &a_frame, TaskScratch &a_scratch,
+                         SensorValues &a_values);
+  std::uint32_t StepObstacleDetection(std::uint32_t a_step,
+                                      const SensorFrame &a_frame,
+                                      TaskScratch &a_scratch,
+                                      SensorValues &a_values);
+  std::uint32_t UpdateObstacleType(RE::Actor *a_actor,
+                                   const RE::NiPoint3 &a_direction,
+                                   Channel a_channel);
+  // One [Array] ray per step (player only)
+  std::uint32_t StepArray(std::uint32_t a_step, const SensorFrame &a_frame,
+                          TaskScratch &a_scratch, SensorValues &a_values);
+  // One arc segment per step, stopping at the first hit
+  std::uint32_t StepLanding(std::uint32_t a_step, const SensorFrame &a_frame,
+                            SensorValues &a_values);
+  float UpdateVerticality(RE::Actor *a_actor, Channel a_channel,
                           const RE::NiPoint3 &a_pos,
                           const RE::NiPoint3 &a_offset,
                           const RE::NiPoint3 &a_vel, float a_predictionTime,
                           float a_slantAngle = 7.0f);
 
-  void UpdateSurfaceInfo(RE::PlayerCharacter *a_player);
+  // [Supersample] Ray history of a player channel, or null when it casts a
+  // single fixed ray (other actors and channels, or iFrames = 1)
+  TemporalSampler *GetSampler(RE::Actor *a_actor, Channel a_channel);
+  void ClearSamples(ChannelMask a_channels);
+  // Offset of the next ray across a_dir: sideways and up
+  RE::NiPoint3 GetWallJitter(TemporalSampler *a_sampler,
+                             const RE::NiPoint3 &a_dir);
+  // Median wall distance of the kept rays, measured along the current ray
+  // from a_origin; a_reach when they mostly missed
+  float CombineWall(TemporalSampler &a_sampler, Channel a_channel,
+                    const RE::NiPoint3 &a_origin, const RE::NiPoint3 &a_dir,
+                    float a_min, float a_reach);
+  // Spread of a_channel's kept rays, 0 without supersampling
+  float GetRoughness(RE::Actor *a_actor, Channel a_channel);
+
+  // Keeps a player ray's hit for a_channel; a null a_output is a miss
+  void RecordHit(RE::Actor *a_actor, Channel a_channel,
+                 const RE::NiPoint3 &a_start, const RE::NiPoint3 &a_end,
+                 const RE::hkpWorldRayCastOutput *a_output);
+
+  // Water depth at the feet, ahead and the distance to shore, from the
+  // cached cell water plane; only water volumes cast a ray
+  void UpdateWaterInfo(RE::Actor *a_actor, SensorValues &a_values);
+  // Reads the water depth UpdateWaterInfo wrote to a_values; the material
+  // ray drops from a_origin
+  void UpdateSurfaceInfo(RE::Actor *a_actor, const RE::NiPoint3 &a_origin,
+                         SensorValues &a_values);
+  // True when the player's surface should be sampled this tick: a footfall
+  // arrived (a_origin is then under that foot), the fallback timer ran out
+  // or a_force (a resample) asks for it
+  bool TakeSurfaceSample(RE::PlayerCharacter *a_player, bool a_force,
+                         RE::NiPoint3 &a_origin);
+  // Runs the queued player resample: every task writing a requested sweep
+  // channel, to completion, from the player's current position
+  void ResamplePlayer(RE::PlayerCharacter *a_player, ChannelMask a_channels);
+
+  // Stores the masked channels and mirrors them to their globals
+  void Publish(const SensorValues &a_values, ChannelMask a_channels);
 
   enum class SurfaceType : std::uint32_t {
     kDefault = 0,
@@ -101,6 +317,10 @@ private:
     kActor = 2
   };
 
+  // Surface type for a ray or footstep material and the layer it was on
+  static SurfaceType GetSurfaceType(RE::MATERIAL_ID a_material,
+                                    RE::COL_LAYER a_layer);
+
   RaySenseLogic() = default;
   ~RaySenseLogic() = default;
   RaySenseLogic(const RaySenseLogic &) = delete;
@@ -108,50 +328,97 @@ private:
   RaySenseLogic &operator=(const RaySenseLogic &) = delete;
   RaySenseLogic &operator=(const RaySenseLogic &&) = delete;
 
-  RE::TESGlobal *_verticalityFrontGlobal{nullptr};
-  RE::TESGlobal *_verticalityLeftGlobal{nullptr};
-  RE::TESGlobal *_verticalityRightGlobal{nullptr};
-  RE::TESGlobal *_verticalityObstacleGlobal{nullptr};
-  RE::TESGlobal *_wallFrontGlobal{nullptr};
-  RE::TESGlobal *_wallFrontLGlobal{nullptr};
-  RE::TESGlobal *_wallFrontRGlobal{nullptr};
-  RE::TESGlobal *_wallLeftGlobal{nullptr};
-  RE::TESGlobal *_wallRightGlobal{nullptr};
-  RE::TESGlobal *_obstacleTypeFrontGlobal{nullptr};
-  RE::TESGlobal *_obstacleTypeLeftGlobal{nullptr};
-  RE::TESGlobal *_obstacleTypeRightGlobal{nullptr};
-  RE::TESGlobal *_verticalityPlayerGlobal{nullptr};
-  RE::TESGlobal *_surfaceTypeGlobal{nullptr};
-  RE::TESGlobal *_platformTypeGlobal{nullptr};
+  // Indexed by Channel; null when the plugin does not define the global
+  std::array<RE::TESGlobal *, CHANNEL_COUNT> _globals{};
   RE::TESGlobal *_rawMaterialIDGlobal{nullptr};
   RE::TESGlobal *_rawLayerIDGlobal{nullptr};
   RE::NiPoint3 _lastUpdatePos;
-  float _lastUpdateAngle{0.0f};
+  float _elapsedSinceUpdate{0.0f};
+  float _tickInterval{0.0f}; // 0 = every frame
+  float _tickAccumulator{0.0f};
+  bool _tickMidairFullRate{true};
+  bool _predictPosition{false}; // Sensing runs before the player update
+  float _reactionTime{0.0f};     // [Lookahead], 0 = fixed offsets
+  float _minOffset{0.0f};
+  float _maxOffset{0.0f};
+  float _minReach{0.0f};
+  std::uint32_t _landingSegments{6}; // [Landing] iMaxSegments
+  float _landingSegmentLength{150.0f};
+  float _jitterRadius{0.0f}; // [Supersample], 0 = one fixed ray
+  float _surfaceInterval{0.0f}; // Fallback between footfalls, 0 = every tick
+  float _surfaceElapsed{0.0f};
+  // Player channels queued by Resample for the next update
+  std::atomic<ChannelMask> _resampleRequested{0};
+
+  // Held by every sensing entry point; Resample may come from any thread
+  std::mutex _senseLock;
   bool _initialized{false};
 
   // Internal storage for values (Thread-safe for OAR)
-  std::atomic<float> _frontDiff{0.0f};
-  std::atomic<float> _leftDiff{0.0f};
-  std::atomic<float> _rightDiff{0.0f};
-  std::atomic<float> _obstacleVaultDist{0.0f};
-  std::atomic<float> _wallFrontDist{0.0f};
-  std::atomic<float> _wallFrontLDist{0.0f};
-  std::atomic<float> _wallFrontRDist{0.0f};
-  std::atomic<float> _wallLeftDist{0.0f};
-  std::atomic<float> _wallRightDist{0.0f};
-  std::atomic<float> _playerHeight{0.0f};
-  std::atomic<float> _surfaceType{0.0f};
-  std::atomic<float> _platformType{0.0f};
-  std::atomic<std::uint32_t> _obstacleTypeFront{0};
-  std::atomic<std::uint32_t> _obstacleTypeLeft{0};
-  std::atomic<std::uint32_t> _obstacleTypeRight{0};
+  std::array<std::atomic<float>, CHANNEL_COUNT> _values{};
+
+  // Player sweep state, possibly spread over several frames
+  SensorGovernor _governor;
+  SensorFrame _sweepFrame;
+  SensorValues _sweepValues{};
+  TaskScratch _sweepScratch;
+  SensorPool _pool;
+
+  // Active environment profile
+  Settings::SensorProfile _profile;
+  std::uint32_t _profileIndex{SensorProfiles::NONE};
+  // Every ray cast, from any thread
+  static inline std::atomic<std::uint64_t> _rayCount{0};
+  // Rays answered by the character controller instead
+  static inline std::atomic<std::uint64_t> _raysAvoided{0};
+
+  // Controller fusion state; support bodies are compared, not dereferenced
+  struct SurfaceCache {
+    const void *support{nullptr};
+    RE::MATERIAL_ID soundMID{RE::MATERIAL_ID::kNone};
+    RE::MATERIAL_ID rayMID{RE::MATERIAL_ID::kNone};
+    RE::COL_LAYER layer{RE::COL_LAYER::kUnidentified};
+    bool onActor{false};
+  };
+  SurfaceCache _surfaceCache;
+  const void *_heightSupport{nullptr};
+  LandMaterialCache _landMaterials;
+
+  // Invalidation state
+  ChannelMask _dirty{SWEEP_CHANNELS};
+  ChannelMask _suppressed{0}; // Held by ClipSuppression this frame
+  std::uint32_t _warmupTask{TASK_COUNT}; // Next task to warm, TASK_COUNT = done
+  std::array<HitList, TASK_COUNT> _hits;
+  // Player hits per channel, written from pool threads and read by OAR
+  mutable std::mutex _hitSampleLock;
+  std::array<HitSample, CHANNEL_COUNT> _hitSamples{};
+  // Player ray histories and their last spread, each written only by the
+  // task that owns the channel
+  std::array<TemporalSampler, CHANNEL_COUNT> _samplers{};
+  std::array<float, CHANNEL_COUNT> _roughness{};
+  // [Array] layout, the player's distance per element from the last
+  // finished pass, and what was last published with ArrayNearest
+  SensorArray _array;
+  std::array<float, SensorArray::MAX_ELEMENTS> _arraySweep{};
+  std::array<std::atomic<float>, SensorArray::MAX_ELEMENTS> _arrayValues{};
+  // List the calling thread's rays record into, set around StepTask
+  static inline thread_local HitList *_recordHits{nullptr};
+  RE::TESObjectCELL *_lastCell{nullptr};       // Compared, never dereferenced
+  RE::TESWorldSpace *_lastWorldspace{nullptr}; // Compared, never dereferenced
+
   // Helper for RayCasting to reduce duplication
-  bool PerformRayCast(RE::PlayerCharacter *a_player,
-                      const RE::NiPoint3 &a_start, const RE::NiPoint3 &a_end,
+  static void CastRayLocked(RE::bhkWorld *a_bhkWorld, RE::hkpWorld *a_hkpWorld,
+                            const RE::hkpWorldRayCastInput &a_input,
+                            RE::hkpWorldRayCastOutput &a_output);
+  bool PerformRayCast(RE::Actor *a_actor, const RE::NiPoint3 &a_start,
+                      const RE::NiPoint3 &a_end,
                       RE::hkpWorldRayCastOutput &a_output);
+  // Endpoints already in Havok units
+  bool PerformHavokRayCast(RE::Actor *a_actor, const RE::hkVector4 &a_from,
+                           const RE::hkVector4 &a_to,
+                           RE::hkpWorldRayCastOutput &a_output);
 
-  bool PerformWaterRayCast(RE::PlayerCharacter *a_player,
-                           const RE::NiPoint3 &a_start,
+  bool PerformWaterRayCast(RE::Actor *a_actor, const RE::NiPoint3 &a_start,
                            const RE::NiPoint3 &a_end,
                            RE::hkpWorldRayCastOutput &a_output);
 
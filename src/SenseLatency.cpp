@@ -0,0 +1,81 @@
+#include "SenseLatency.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
+
+void SenseLatency::Configure(bool a_enabled, bool a_sampleFirst) {
+  _sampleFirst = a_sampleFirst;
+  _enabled.store(a_enabled, std::memory_order_relaxed);
+
+  if (a_enabled) {
+    SKSE::log::info("SenseLatency: Enabled (sensing {} the player update)",
+                    a_sampleFirst ? "before" : "after");
+  }
+}
+
+void SenseLatency::Stamp(ChannelMask a_channels) {
+  const auto frame = _frame.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    if (a_channels & (1u << i))
+      _stamps[i].store(frame, std::memory_order_relaxed);
+  }
+}
+
+void SenseLatency::OnConsume(Channel a_channel) {
+  const auto index = ToIndex(a_channel);
+  if (index >= CHANNEL_COUNT)
+    return;
+
+  const auto stamp = _stamps[index].load(std::memory_order_relaxed);
+  if (!stamp)
+    return; // Never sampled
+  const auto age = _frame.load(std::memory_order_relaxed) - stamp;
+  const auto bucket = std::min<std::uint64_t>(age, BUCKETS - 1);
+  _histogram[index][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+bool SenseLatency::WriteReport() {
+  auto path = SKSE::log::log_directory();
+  if (!path)
+    return false;
+
+  *path /= "RaySense_Latency.txt";
+  std::ofstream file(*path);
+  if (!file.is_open()) {
+    SKSE::log::error("SenseLatency: Failed to open {}", path->string());
+    return false;
+  }
+
+  file << std::format("RaySense sample-to-condition latency ({} updates, "
+                      "sensing {} the player update)\n\n",
+                      _frame.load(std::memory_order_relaxed),
+                      _sampleFirst ? "before" : "after");
+  file << std::format("{:<20} {:>10} {:>8} {:>7} {:>7} {:>7} {:>7} {:>7}\n",
+                      "Channel", "Reads", "Mean", "0", "1", "2", "3", "4+");
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    std::array<std::uint64_t, BUCKETS> counts{};
+    std::uint64_t reads = 0;
+    std::uint64_t weighted = 0;
+    for (std::size_t b = 0; b < BUCKETS; ++b) {
+      counts[b] = _histogram[i][b].load(std::memory_order_relaxed);
+      reads += counts[b];
+      weighted += counts[b] * b;
+    }
+    if (!reads)
+      continue;
+
+    // Shares per bucket; 4+ counts as 4 in the mean
+    auto Share = [&](std::size_t a_bucket) {
+      return counts[a_bucket] * 100.0 / reads;
+    };
+    file << std::format(
+        "{:<20} {:>10} {:>8.2f} {:>6.1f}% {:>6.1f}% {:>6.1f}% {:>6.1f}% "
+        "{:>6.1f}%\n",
+        GetChannelName(static_cast<Channel>(i)), reads,
+        static_cast<double>(weighted) / reads, Share(0), Share(1), Share(2),
+        Share(3), Share(4));
+  }
+
+  SKSE::log::info("SenseLatency: Wrote report to {}", path->string());
+  return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "PCH.h"
+#include "SensorChannels.h"
+#include <array>
+#include <atomic>
+
+// Sample-to-consumption latency in player updates.
+// Every channel remembers the update in which it was last published or
+// confirmed unchanged; every RaySense condition evaluated for the player
+// adds how many updates old its channel was to a histogram. 0 means the
+// condition saw this update's position, 1 means the previous one's.
+class SenseLatency {
+public:
+  static SenseLatency *GetSingleton() {
+    static SenseLatency singleton;
+    return &singleton;
+  }
+
+  static constexpr std::size_t BUCKETS = 5; // 0..3 updates, then 4+
+
+  static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+  void Configure(bool a_enabled, bool a_sampleFirst);
+
+  // Main thread, at the start of every player update
+  void BeginFrame() { _frame.fetch_add(1, std::memory_order_relaxed); }
+  // a_channels are current as of this update
+  void Stamp(ChannelMask a_channels);
+  // Called from behavior graph threads during condition evaluation.
+  void OnConsume(Channel a_channel);
+
+  bool WriteReport();
+
+private:
+  SenseLatency() = default;
+  ~SenseLatency() = default;
+  SenseLatency(const SenseLatency &) = delete;
+  SenseLatency(const SenseLatency &&) = delete;
+  SenseLatency &operator=(const SenseLatency &) = delete;
+  SenseLatency &operator=(const SenseLatency &&) = delete;
+
+  static inline std::atomic<bool> _enabled{false};
+  bool _sampleFirst{false};
+
+  std::atomic<std::uint64_t> _frame{0};
+  std::array<std::atomic<std::uint64_t>, CHANNEL_COUNT> _stamps{};
+  std::array<std::array<std::atomic<std::uint64_t>, BUCKETS>, CHANNEL_COUNT>
+      _histogram{};
+};
@@ -0,0 +1,53 @@
+#include "SensingGate.h"
+
+void SensingGate::Install() {
+  if (auto *ui = RE::UI::GetSingleton()) {
+    ui->AddEventSink<RE::MenuOpenCloseEvent>(this);
+    SKSE::log::info("SensingGate: Registered menu event sink");
+  }
+  if (auto *events = RE::ScriptEventSourceHolder::GetSingleton()) {
+    events->AddEventSink<RE::TESCellAttachDetachEvent>(this);
+    SKSE::log::info("SensingGate: Registered cell attach/detach sink");
+  }
+}
+
+bool SensingGate::IsSuspended() const {
+  if (_loading.load(std::memory_order_relaxed) ||
+      _detached.load(std::memory_order_relaxed))
+    return true;
+
+  auto *ui = RE::UI::GetSingleton();
+  return ui && ui->GameIsPaused();
+}
+
+void SensingGate::OnGameLoaded() {
+  _detached.store(false, std::memory_order_relaxed);
+  _transition.store(true, std::memory_order_relaxed);
+}
+
+RE::BSEventNotifyControl
+SensingGate::ProcessEvent(const RE::MenuOpenCloseEvent *a_event,
+                          RE::BSTEventSource<RE::MenuOpenCloseEvent> *) {
+  if (a_event && a_event->menuName == RE::LoadingMenu::MENU_NAME) {
+    _loading.store(a_event->opening, std::memory_order_relaxed);
+    if (!a_event->opening) {
+      // The player is placed by the time the loading screen closes
+      _detached.store(false, std::memory_order_relaxed);
+      _transition.store(true, std::memory_order_relaxed);
+    }
+  }
+  return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl SensingGate::ProcessEvent(
+    const RE::TESCellAttachDetachEvent *a_event,
+    RE::BSTEventSource<RE::TESCellAttachDetachEvent> *) {
+  if (!a_event || !a_event->reference || !a_event->reference->IsPlayerRef())
+    return RE::BSEventNotifyControl::kContinue;
+
+  // The player is detached while a load door moves it to another cell
+  _detached.store(!a_event->attached, std::memory_order_relaxed);
+  if (a_event->attached)
+    _transition.store(true, std::memory_order_relaxed);
+  return RE::BSEventNotifyControl::kContinue;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "PCH.h"
+#include <atomic>
+
+// Decides when sensing may run.
+// Sensing is suspended while the game is paused or loading, and while the
+// player is detached between cells. Leaving a loading screen or attaching
+// the player to a new cell is reported once as a transition so caches built
+// against the old world can be dropped.
+class SensingGate : public RE::BSTEventSink<RE::MenuOpenCloseEvent>,
+                    public RE::BSTEventSink<RE::TESCellAttachDetachEvent> {
+public:
+  static SensingGate *GetSingleton() {
+    static SensingGate singleton;
+    return &singleton;
+  }
+
+  void Install();
+
+  [[nodiscard]] bool IsSuspended() const;
+  // True once after each transition (main thread)
+  bool ConsumeTransition() {
+    return _transition.exchange(false, std::memory_order_relaxed);
+  }
+  // A loaded save or a new game places the player without necessarily
+  // sending an attach event, so a detach from the old session must not
+  // outlive it.
+  void OnGameLoaded();
+
+  RE::BSEventNotifyControl
+  ProcessEvent(const RE::MenuOpenCloseEvent *a_event,
+               RE::BSTEventSource<RE::MenuOpenCloseEvent> *a_source) override;
+  RE::BSEventNotifyControl ProcessEvent(
+      const RE::TESCellAttachDetachEvent *a_event,
+      RE::BSTEventSource<RE::TESCellAttachDetachEvent> *a_source) override;
+
+private:
+  SensingGate() = default;
+  ~SensingGate() = default;
+  SensingGate(const SensingGate &) = delete;
+  SensingGate(const SensingGate &&) = delete;
+  SensingGate &operator=(const SensingGate &) = delete;
+  SensingGate &operator=(const SensingGate &&) = delete;
+
+  std::atomic<bool> _loading{false};
+  std::atomic<bool> _detached{false};
+  std::atomic<bool> _transition{false};
+};
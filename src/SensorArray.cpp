@@ -0,0 +1,91 @@
+#include "SensorArray.h"
+#include <algorithm>
+
+namespace {
+// Unit headings clockwise from straight ahead in 22.5 degree steps, as
+// (right, forward)
+constexpr float PATTERN[SensorArray::MAX_DIRECTIONS][2] = {
+    {0.0f, 1.0f},
+    {0.38268343f, 0.92387953f},
+    {0.70710678f, 0.70710678f},
+    {0.92387953f, 0.38268343f},
+    {1.0f, 0.0f},
+    {0.92387953f, -0.38268343f},
+    {0.70710678f, -0.70710678f},
+    {0.38268343f, -0.92387953f},
+    {0.0f, -1.0f},
+    {-0.38268343f, -0.92387953f},
+    {-0.70710678f, -0.70710678f},
+    {-0.92387953f, -0.38268343f},
+    {-1.0f, 0.0f},
+    {-0.92387953f, 0.38268343f},
+    {-0.70710678f, 0.70710678f},
+    {-0.38268343f, 0.92387953f}};
+} // namespace
+
+void SensorArray::Configure(std::uint32_t a_directions,
+                            const std::vector<float> &a_heights,
+                            float a_frontReach, float a_backReach) {
+  _count = 0;
+  _directions = 0;
+  _heights = 0;
+  _maxReach = 0.0f;
+  if (a_directions == 0 || a_heights.empty())
+    return;
+
+  _directions = a_directions <= 4 ? 4 : (a_directions <= 8 ? 8 : 16);
+  _heights = std::min<std::uint32_t>(
+      static_cast<std::uint32_t>(a_heights.size()), MAX_HEIGHTS);
+  const std::uint32_t stride = MAX_DIRECTIONS / _directions;
+
+  for (std::uint32_t h = 0; h < _heights; ++h) {
+    for (std::uint32_t d = 0; d < _directions; ++d) {
+      const float *heading = PATTERN[d * stride];
+      // Forward component 1 ahead, -1 behind
+      const float blend = 0.5f * (1.0f + heading[1]);
+      const float reach = a_backReach + (a_frontReach - a_backReach) * blend;
+
+      auto &element = _elements[h * _directions + d];
+      element.x = heading[0] * reach;
+      element.y = heading[1] * reach;
+      element.height = a_heights[h];
+      element.reach = reach;
+      _maxReach = std::max(_maxReach, reach);
+    }
+  }
+  _count = _heights * _directions;
+}
+
+std::uint32_t SensorArray::GetIndex(std::uint32_t a_direction,
+                                    std::uint32_t a_height) const {
+  if (a_direction >= _directions || a_height >= _heights)
+    return MAX_ELEMENTS;
+  return a_height * _directions + a_direction;
+}
+
+void SensorArray::Generate(const Vector &a_pos, const Vector &a_forward,
+                           const Vector &a_right, float a_scale,
+                           __m128 *a_from, __m128 *a_to) const {
+  // Basis and origin are scaled once, so the world scale costs nothing per
+  // ray. Heights are along world up: actors stay upright.
+  const __m128 scale = _mm_set1_ps(a_scale);
+  const __m128 origin =
+      _mm_mul_ps(_mm_setr_ps(a_pos.x, a_pos.y, a_pos.z, 0.0f), scale);
+  const __m128 right =
+      _mm_mul_ps(_mm_setr_ps(a_right.x, a_right.y, a_right.z, 0.0f), scale);
+  const __m128 forward = _mm_mul_ps(
+      _mm_setr_ps(a_forward.x, a_forward.y, a_forward.z, 0.0f), scale);
+  const __m128 up = _mm_setr_ps(0.0f, 0.0f, a_scale, 0.0f);
+
+  for (std::uint32_t i = 0; i < _count; ++i) {
+    const __m128 local = _mm_load_ps(&_elements[i].x);
+    const __m128 x = _mm_shuffle_ps(local, local, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 y = _mm_shuffle_ps(local, local, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 z = _mm_shuffle_ps(local, local, _MM_SHUFFLE(2, 2, 2, 2));
+
+    const __m128 from = _mm_add_ps(origin, _mm_mul_ps(up, z));
+    a_from[i] = from;
+    a_to[i] = _mm_add_ps(
+        from, _mm_add_ps(_mm_mul_ps(right, x), _mm_mul_ps(forward, y)));
+  }
+}
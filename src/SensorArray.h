@@ -0,0 +1,70 @@
+#pragma once
+
+// Kept free of game headers so host tools can check the generated rays.
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xmmintrin.h>
+
+// Declarative radial sensor array: rings of horizontal rays around an
+// actor, one per direction of a fixed pattern at each configured height.
+// Directions come from a constexpr table of 16 headings; 4 or 8 directions
+// take every 4th or 2nd entry. Reach blends from the front reach straight
+// ahead to the back reach straight behind.
+class SensorArray {
+public:
+  static constexpr std::uint32_t MAX_DIRECTIONS = 16;
+  static constexpr std::uint32_t MAX_HEIGHTS = 4;
+  static constexpr std::uint32_t MAX_ELEMENTS = MAX_DIRECTIONS * MAX_HEIGHTS;
+
+  // One ray in the actor's local frame: x right, y forward, z up. The
+  // direction is already scaled by the reach, so the endpoint is a single
+  // multiply-add per axis.
+  struct alignas(16) Element {
+    float x{0.0f};
+    float y{0.0f};
+    float height{0.0f};
+    float reach{0.0f};
+  };
+
+  struct Vector {
+    float x{0.0f};
+    float y{0.0f};
+    float z{0.0f};
+  };
+
+  // a_directions rounds up to 4, 8 or 16 (0 = off). Heights past
+  // MAX_HEIGHTS are ignored.
+  void Configure(std::uint32_t a_directions,
+                 const std::vector<float> &a_heights, float a_frontReach,
+                 float a_backReach);
+
+  [[nodiscard]] bool IsEnabled() const { return _count > 0; }
+  [[nodiscard]] std::uint32_t GetCount() const { return _count; }
+  [[nodiscard]] std::uint32_t GetDirections() const { return _directions; }
+  [[nodiscard]] std::uint32_t GetHeights() const { return _heights; }
+  [[nodiscard]] float GetMaxReach() const { return _maxReach; }
+  [[nodiscard]] const Element &GetElement(std::uint32_t a_index) const {
+    return _elements[a_index];
+  }
+  // Element for direction a_direction (0 = ahead, clockwise) of ring
+  // a_height, or MAX_ELEMENTS when either is out of range
+  [[nodiscard]] std::uint32_t GetIndex(std::uint32_t a_direction,
+                                       std::uint32_t a_height) const;
+
+  // Ray endpoints of every element, already scaled by a_scale (the Havok
+  // world scale), from the actor's position and heading axes. One pass of
+  // 4-wide vector math: every endpoint is a broadcast of the element's
+  // local coordinates against the pre-scaled basis.
+  void Generate(const Vector &a_pos, const Vector &a_forward,
+                const Vector &a_right, float a_scale, __m128 *a_from,
+                __m128 *a_to) const;
+
+private:
+  std::array<Element, MAX_ELEMENTS> _elements{};
+  std::uint32_t _count{0};
+  std::uint32_t _directions{0};
+  std::uint32_t _heights{0};
+  float _maxReach{0.0f};
+};
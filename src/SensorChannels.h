@@ -0,0 +1,158 @@
+#pragma once
+
+// Kept free of game headers so host tools can share the channel list.
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+// Every value RaySense publishes to OAR, one entry per condition input.
+enum class Channel : std::uint32_t {
+  kFront = 0,
+  kLeft,
+  kRight,
+  kPlayerHeight,
+  kSurface,
+  kPlatform,
+  kObstacle,
+  kWallFront,
+  kWallFrontL,
+  kWallFrontR,
+  kWallLeft,
+  kWallRight,
+  kObstacleTypeFront,
+  kObstacleTypeLeft,
+  kObstacleTypeRight,
+  kWaterDepth,
+  kWaterAhead,
+  kShoreDistance,
+  kLandingTime,
+  kLandingHeight,
+  kLandingSurface,
+  kFrontRoughness,
+  kWallRoughness,
+  kArrayNearest,
+
+  kTotal
+};
+
+using ChannelMask = std::uint32_t;
+
+constexpr std::size_t CHANNEL_COUNT = static_cast<std::size_t>(Channel::kTotal);
+constexpr ChannelMask ALL_CHANNELS = (1u << CHANNEL_COUNT) - 1;
+
+constexpr std::size_t ToIndex(Channel a_channel) {
+  return static_cast<std::size_t>(a_channel);
+}
+
+constexpr ChannelMask ToMask(Channel a_channel) {
+  return 1u << static_cast<std::uint32_t>(a_channel);
+}
+
+constexpr std::string_view GetChannelName(Channel a_channel) {
+  constexpr std::string_view NAMES[] = {"Front",
+                                        "Left",
+                                        "Right",
+                                        "PlayerHeight",
+                                        "Surface",
+                                        "Platform",
+                                        "Obstacle",
+                                        "WallFront",
+                                        "WallFrontL",
+                                        "WallFrontR",
+                                        "WallLeft",
+                                        "WallRight",
+                                        "ObstacleTypeFront",
+                                        "ObstacleTypeLeft",
+                                        "ObstacleTypeRight",
+                                        "WaterDepth",
+                                        "WaterAhead",
+                                        "ShoreDistance",
+                                        "LandingTime",
+                                        "LandingHeight",
+                                        "LandingSurface",
+                                        "FrontRoughness",
+                                        "WallRoughness",
+                                        "ArrayNearest"};
+  static_assert(std::size(NAMES) == CHANNEL_COUNT);
+  const auto index = static_cast<std::size_t>(a_channel);
+  return index < CHANNEL_COUNT ? NAMES[index] : std::string_view("Unknown");
+}
+
+// Comma-separated channel names, case-insensitive, or "All". Unknown names
+// are ignored.
+constexpr ChannelMask ParseChannels(std::string_view a_list) {
+  constexpr auto Lower = [](char a_char) {
+    return a_char >= 'A' && a_char <= 'Z'
+               ? static_cast<char>(a_char - 'A' + 'a')
+               : a_char;
+  };
+  constexpr auto Equals = [Lower](std::string_view a_lhs,
+                                  std::string_view a_rhs) {
+    if (a_lhs.size() != a_rhs.size())
+      return false;
+    for (std::size_t i = 0; i < a_lhs.size(); ++i) {
+      if (Lower(a_lhs[i]) != Lower(a_rhs[i]))
+        return false;
+    }
+    return true;
+  };
+
+  ChannelMask mask = 0;
+  for (;;) {
+    const auto end = a_list.find(',');
+    auto item = a_list.substr(0, end);
+    while (!item.empty() && (item.front() == ' ' || item.front() == '\t'))
+      item.remove_prefix(1);
+    while (!item.empty() && (item.back() == ' ' || item.back() == '\t' ||
+                             item.back() == '\r'))
+      item.remove_suffix(1);
+
+    if (Equals(item, "all"))
+      mask |= ALL_CHANNELS;
+    for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+      if (Equals(item, GetChannelName(static_cast<Channel>(i))))
+        mask |= ToMask(static_cast<Channel>(i));
+    }
+
+    if (end == std::string_view::npos)
+      return mask;
+    a_list.remove_prefix(end + 1);
+  }
+}
+
+// Maps the RaySense_Verticality sensor index to its channel.
+constexpr Channel GetVerticalityChannel(int a_sensorIndex) {
+  switch (a_sensorIndex) {
+  case 1:
+    return Channel::kLeft;
+  case 2:
+    return Channel::kRight;
+  case 3:
+    return Channel::kPlayerHeight;
+  case 4:
+    return Channel::kSurface;
+  case 5:
+    return Channel::kPlatform;
+  case 6:
+    return Channel::kWaterDepth;
+  case 7:
+    return Channel::kWaterAhead;
+  case 8:
+    return Channel::kShoreDistance;
+  case 9:
+    return Channel::kLandingTime;
+  case 10:
+    return Channel::kLandingHeight;
+  case 11:
+    return Channel::kLandingSurface;
+  case 12:
+    return Channel::kFrontRoughness;
+  case 13:
+    return Channel::kWallRoughness;
+  case 14:
+    return Channel::kArrayNearest;
+  default:
+    return Channel::kFront;
+  }
+}
@@ -0,0 +1,110 @@
+#include "SensorGovernor.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
+
+void SensorGovernor::SetBudget(float a_budgetUs) {
+  _budgetNs = a_budgetUs > 0.0f
+                  ? static_cast<std::int64_t>(a_budgetUs * 1000.0f)
+                  : 0;
+  if (_budgetNs > 0)
+    SKSE::log::info("SensorGovernor: Budget {:.0f} us per frame", a_budgetUs);
+}
+
+std::uint32_t SensorGovernor::AddTask(const char *a_name,
+                                      ChannelMask a_channels) {
+  Task task;
+  task.name = a_name;
+  task.channels = a_channels;
+  _tasks.push_back(task);
+  return static_cast<std::uint32_t>(_tasks.size() - 1);
+}
+
+bool SensorGovernor::IsIdle() const {
+  for (const auto &task : _tasks) {
+    if (task.pending)
+      return false;
+  }
+  return true;
+}
+
+void SensorGovernor::BeginSweep(ChannelMask a_channels) {
+  for (std::uint32_t i = 0; i < _tasks.size(); ++i) {
+    if (_tasks[i].channels & a_channels)
+      Restart(i);
+  }
+}
+
+void SensorGovernor::Restart(std::uint32_t a_task) {
+  _tasks[a_task].pending = true;
+  _tasks[a_task].step = 0;
+}
+
+void SensorGovernor::Clear() {
+  for (auto &task : _tasks) {
+    task.pending = false;
+    task.step = 0;
+  }
+}
+
+void SensorGovernor::EndFrame(std::int64_t a_elapsedNs) {
+  ++_frames;
+  _totalNs += a_elapsedNs;
+  _maxNs = std::max(_maxNs, a_elapsedNs);
+
+  if (_budgetNs > 0 && a_elapsedNs > _budgetNs) {
+    ++_overruns;
+    _maxOverrunNs = std::max(_maxOverrunNs, a_elapsedNs - _budgetNs);
+  }
+
+  std::uint64_t deferred = 0;
+  for (auto &task : _tasks) {
+    if (task.pending) {
+      ++task.deferrals;
+      ++deferred;
+    }
+  }
+  if (deferred) {
+    ++_carriedFrames;
+    _deferredTasks += deferred;
+  }
+}
+
+void SensorGovernor::WriteReport() const {
+  auto path = SKSE::log::log_directory();
+  if (!path)
+    return;
+
+  *path /= "RaySense_Governor.txt";
+  std::ofstream file(*path);
+  if (!file.is_open()) {
+    SKSE::log::error("SensorGovernor: Failed to open {}", path->string());
+    return;
+  }
+
+  const double frames =
+      static_cast<double>(std::max<std::uint64_t>(_frames, 1));
+  file << std::format("Budget: {}\n",
+                      _budgetNs > 0
+                          ? std::format("{:.0f} us", _budgetNs / 1000.0)
+                          : std::string("unlimited"));
+  file << std::format("Frames: {}\n", _frames);
+  file << std::format("Sensing time: mean {:.1f} us, max {:.1f} us\n",
+                      _totalNs / frames / 1000.0, _maxNs / 1000.0);
+  file << std::format("Budget overruns: {} ({:.2f}%), worst by {:.1f} us\n",
+                      _overruns, 100.0 * _overruns / frames,
+                      _maxOverrunNs / 1000.0);
+  file << std::format("Frames carrying work: {} ({:.2f}%)\n", _carriedFrames,
+                      100.0 * _carriedFrames / frames);
+  file << std::format("Deferred tasks: {} ({:.2f} per frame)\n\n",
+                      _deferredTasks, _deferredTasks / frames);
+
+  file << std::format("{:<16} {:>10} {:>9}\n", "Task", "Deferrals",
+                      "Critical");
+  for (const auto &task : _tasks) {
+    file << std::format("{:<16} {:>10} {:>9}\n", task.name, task.deferrals,
+                        task.critical ? "yes" : "no");
+  }
+
+  SKSE::log::info("SensorGovernor: Wrote {}", path->string());
+}
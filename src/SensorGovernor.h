@@ -0,0 +1,93 @@
+#pragma once
+
+#include "PCH.h"
+#include "SensorChannels.h"
+#include "Trace.h"
+#include <vector>
+
+// Runs resumable sensor tasks against a per-frame time budget.
+// Each task is an explicit state machine: one step casts at most one ray and
+// returns the next step, so work can stop between any two rays and resume on
+// the next frame. Tasks run in the order they were added (highest priority
+// first). Critical tasks ignore the budget so landing prediction never
+// starves.
+class SensorGovernor {
+public:
+  static constexpr std::uint32_t DONE = 0xFFFFFFFF;
+
+  struct Task {
+    const char *name{nullptr};
+    ChannelMask channels{0};
+    bool critical{false};
+    bool pending{false};
+    std::uint32_t step{0};
+    std::uint64_t deferrals{0}; // Frames this task was left unfinished
+  };
+
+  void SetBudget(float a_budgetUs);
+  [[nodiscard]] bool HasBudget() const { return _budgetNs > 0; }
+
+  std::uint32_t AddTask(const char *a_name, ChannelMask a_channels);
+  Task &GetTask(std::uint32_t a_task) { return _tasks[a_task]; }
+
+  [[nodiscard]] bool IsIdle() const;
+  // Queues every task writing any of a_channels from its first step
+  void BeginSweep(ChannelMask a_channels = ALL_CHANNELS);
+  // Queues one task from its first step, dropping any progress
+  void Restart(std::uint32_t a_task);
+  void Clear();
+
+  // a_step(index, task) performs task.step and returns the next step or
+  // DONE; a_complete(index, task) runs once a task has finished.
+  template <class StepFn, class CompleteFn>
+  void Run(StepFn &&a_step, CompleteFn &&a_complete) {
+    Trace::Scope scope("Governor");
+    const auto start = Trace::Now();
+
+    auto Advance = [&](std::uint32_t a_index) {
+      auto &task = _tasks[a_index];
+      task.step = a_step(a_index, task);
+      if (task.step == DONE) {
+        task.pending = false;
+        a_complete(a_index, task);
+      }
+    };
+
+    // Critical tasks first and always to completion
+    for (std::uint32_t i = 0; i < _tasks.size(); ++i) {
+      while (_tasks[i].pending && _tasks[i].critical)
+        Advance(i);
+    }
+
+    bool outOfBudget = false;
+    for (std::uint32_t i = 0; i < _tasks.size() && !outOfBudget; ++i) {
+      while (_tasks[i].pending) {
+        if (_budgetNs > 0 && Trace::Now() - start >= _budgetNs) {
+          outOfBudget = true;
+          break;
+        }
+        Advance(i);
+      }
+    }
+
+    EndFrame(Trace::Now() - start);
+  }
+
+  // Writes RaySense_Governor.txt to the SKSE log folder
+  void WriteReport() const;
+
+private:
+  void EndFrame(std::int64_t a_elapsedNs);
+
+  std::vector<Task> _tasks;
+  std::int64_t _budgetNs{0}; // 0 = unlimited
+
+  // Metrics (main thread)
+  std::uint64_t _frames{0};
+  std::uint64_t _overruns{0};      // Frames that ran past the budget
+  std::uint64_t _carriedFrames{0}; // Frames that left work for the next one
+  std::uint64_t _deferredTasks{0}; // Sum of unfinished tasks at frame end
+  std::int64_t _totalNs{0};
+  std::int64_t _maxNs{0};
+  std::int64_t _maxOverrunNs{0};
+};
@@ -0,0 +1,110 @@
+#include "SensorPool.h"
+#include <algorithm>
+
+SensorPool::~SensorPool() { Stop(); }
+
+void SensorPool::Start(std::uint32_t a_threads) {
+  Stop();
+  const auto threads = std::min(a_threads, MAX_THREADS);
+  if (threads < 2)
+    return;
+
+  _queues = std::make_unique<Queue[]>(threads);
+  _queueCount = threads;
+  _stopping = false;
+  for (std::uint32_t i = 1; i < threads; ++i)
+    _helpers.emplace_back([this, i] { HelperLoop(i); });
+}
+
+void SensorPool::Stop() {
+  if (_helpers.empty())
+    return;
+
+  {
+    std::lock_guard lock(_wakeLock);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  for (auto &helper : _helpers)
+    helper.join();
+  _helpers.clear();
+  _queues.reset();
+  _queueCount = 0;
+}
+
+void SensorPool::Dispatch(std::uint32_t a_count, InvokeFn a_invoke,
+                          void *a_context) {
+  if (a_count == 0)
+    return;
+
+  const auto queueCount = _queueCount;
+  _invoke = a_invoke;
+  _context = a_context;
+  _remaining.store(a_count, std::memory_order_relaxed);
+
+  for (std::uint32_t q = 0; q < queueCount; ++q) {
+    std::lock_guard lock(_queues[q].lock);
+    for (std::uint32_t job = q; job < a_count; job += queueCount)
+      _queues[q].jobs.push_back(job);
+  }
+
+  {
+    std::lock_guard lock(_wakeLock);
+    ++_generation;
+  }
+  _wake.notify_all();
+
+  while (RunOne(0)) {
+  }
+  // Helpers may still be finishing jobs they took
+  while (_remaining.load(std::memory_order_acquire) != 0)
+    std::this_thread::yield();
+}
+
+void SensorPool::HelperLoop(std::uint32_t a_queue) {
+  std::uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock lock(_wakeLock);
+      _wake.wait(lock, [&] { return _stopping || _generation != seen; });
+      if (_stopping)
+        return;
+      seen = _generation;
+    }
+    while (RunOne(a_queue)) {
+    }
+  }
+}
+
+bool SensorPool::RunOne(std::uint32_t a_queue) {
+  const auto queueCount = _queueCount;
+  std::uint32_t job = 0;
+  bool found = false;
+
+  {
+    auto &own = _queues[a_queue];
+    std::lock_guard lock(own.lock);
+    if (!own.jobs.empty()) {
+      job = own.jobs.front();
+      own.jobs.pop_front();
+      found = true;
+    }
+  }
+
+  for (std::uint32_t i = 1; !found && i < queueCount; ++i) {
+    auto &victim = _queues[(a_queue + i) % queueCount];
+    std::lock_guard lock(victim.lock);
+    if (!victim.jobs.empty()) {
+      job = victim.jobs.back();
+      victim.jobs.pop_back();
+      found = true;
+    }
+  }
+
+  if (!found)
+    return false;
+
+  _invoke(_context, job);
+  _remaining.fetch_sub(1, std::memory_order_acq_rel);
+  return true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// Kept free of game headers so host tools can benchmark it directly.
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Small work-stealing pool for fanning out independent sensor passes.
+// Run() blocks until every job has finished; the calling thread works on
+// the batch too, so a pool of N threads starts N-1 helpers. Jobs are dealt
+// round-robin into per-thread queues; a thread takes jobs from the front of
+// its own queue and steals from the back of the others once it runs dry.
+// Submit the longest job first: it lands at the front of the caller's
+// queue, and helpers that wake late only steal the short tail.
+class SensorPool {
+public:
+  static constexpr std::uint32_t MAX_THREADS = 4;
+
+  SensorPool() = default;
+  ~SensorPool();
+
+  SensorPool(const SensorPool &) = delete;
+  SensorPool &operator=(const SensorPool &) = delete;
+
+  // Total threads including the caller; values below 2 stop the pool.
+  void Start(std::uint32_t a_threads);
+  void Stop();
+
+  [[nodiscard]] bool IsRunning() const { return !_helpers.empty(); }
+  [[nodiscard]] std::uint32_t GetThreadCount() const {
+    return IsRunning() ? _queueCount : 1;
+  }
+
+  // Calls a_fn(job) for job in [0, a_count). Runs inline when stopped.
+  template <class Fn> void Run(std::uint32_t a_count, Fn &&a_fn) {
+    if (!IsRunning()) {
+      for (std::uint32_t i = 0; i < a_count; ++i)
+        a_fn(i);
+      return;
+    }
+    using Callable = std::remove_reference_t<Fn>;
+    Dispatch(
+        a_count,
+        [](void *a_context, std::uint32_t a_job) {
+          (*static_cast<Callable *>(a_context))(a_job);
+        },
+        const_cast<void *>(static_cast<const void *>(&a_fn)));
+  }
+
+private:
+  using InvokeFn = void (*)(void *, std::uint32_t);
+
+  struct Queue {
+    std::mutex lock;
+    std::deque<std::uint32_t> jobs;
+  };
+
+  void Dispatch(std::uint32_t a_count, InvokeFn a_invoke, void *a_context);
+  void HelperLoop(std::uint32_t a_queue);
+  // Runs one job from a_queue or, failing that, stolen from another queue
+  bool RunOne(std::uint32_t a_queue);
+
+  std::vector<std::thread> _helpers;
+  std::unique_ptr<Queue[]> _queues; // [0] belongs to the caller
+  std::uint32_t _queueCount{0};
+
+  std::mutex _wakeLock;
+  std::condition_variable _wake;
+  std::uint64_t _generation{0};
+  bool _stopping{false};
+
+  // Current batch; written by Dispatch before any of its jobs are queued
+  InvokeFn _invoke{nullptr};
+  void *_context{nullptr};
+  std::atomic<std::uint32_t> _remaining{0};
+};
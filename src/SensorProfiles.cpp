@@ -0,0 +1,103 @@
+#include "SensorProfiles.h"
+#include <algorithm>
+#include <cctype>
+#include <format>
+#include <fstream>
+
+void SensorProfiles::Load(const std::vector<Profile> &a_profiles) {
+  if (a_profiles.empty())
+    return;
+
+  _profiles = a_profiles;
+  _stats.assign(_profiles.size(), Stats{});
+  for (const auto &profile : _profiles) {
+    SKSE::log::info("SensorProfiles: '{}' drop {:.0f}, obstacle {:.0f}/{:.0f}, "
+                    "type {:.0f}, channels {:#x}",
+                    profile.name, profile.dropLength, profile.obstacleReach,
+                    profile.sprintObstacleReach, profile.typeReach,
+                    profile.channels);
+  }
+}
+
+std::uint32_t SensorProfiles::Select(RE::Actor *a_actor) const {
+  auto *cell = a_actor ? a_actor->GetParentCell() : nullptr;
+  const bool interior = cell && cell->IsInteriorCell();
+
+  std::string worldspace;
+  if (auto *world = a_actor ? a_actor->GetWorldspace() : nullptr) {
+    worldspace = world->GetFormEditorID();
+    std::transform(
+        worldspace.begin(), worldspace.end(), worldspace.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  }
+  auto *location = a_actor ? a_actor->GetCurrentLocation() : nullptr;
+
+  std::uint32_t best = 0;
+  int bestScore = -1;
+  for (std::uint32_t i = 0; i < _profiles.size(); ++i) {
+    const auto &profile = _profiles[i];
+    int score = 0;
+
+    if (profile.interior >= 0) {
+      if ((profile.interior == 1) != interior)
+        continue;
+      score += 1;
+    }
+    if (!profile.worldspace.empty()) {
+      if (profile.worldspace != worldspace)
+        continue;
+      score += 2;
+    }
+    if (!profile.locationKeyword.empty()) {
+      if (!location || !location->HasKeywordString(profile.locationKeyword))
+        continue;
+      score += 4;
+    }
+
+    // Ties go to the first profile, so the built-ins win over catch-alls
+    if (score > bestScore) {
+      best = i;
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+void SensorProfiles::AddFrame(std::uint32_t a_index, std::uint64_t a_rays,
+                              std::uint64_t a_avoided) {
+  // Frames before the first cell has been seen have no profile yet
+  if (a_index >= _stats.size())
+    return;
+  auto &stats = _stats[a_index];
+  ++stats.frames;
+  stats.rays += a_rays;
+  stats.maxRays = std::max(stats.maxRays, a_rays);
+  stats.avoided += a_avoided;
+}
+
+void SensorProfiles::WriteReport() const {
+  auto path = SKSE::log::log_directory();
+  if (!path)
+    return;
+
+  *path /= "RaySense_Profiles.txt";
+  std::ofstream file(*path);
+  if (!file.is_open()) {
+    SKSE::log::error("SensorProfiles: Failed to open {}", path->string());
+    return;
+  }
+
+  file << std::format("{:<20} {:>10} {:>12} {:>10} {:>9} {:>9} {:>9}\n",
+                      "Profile", "Frames", "Rays", "Rays/frame", "Max",
+                      "Avoided", "Entered");
+  for (std::size_t i = 0; i < _profiles.size(); ++i) {
+    const auto &stats = _stats[i];
+    const double perFrame =
+        stats.frames ? static_cast<double>(stats.rays) / stats.frames : 0.0;
+    file << std::format("{:<20} {:>10} {:>12} {:>10.2f} {:>9} {:>9} {:>9}\n",
+                        _profiles[i].name, stats.frames, stats.rays, perFrame,
+                        stats.maxRays, stats.avoided, stats.switches);
+  }
+
+  SKSE::log::info("SensorProfiles: Wrote {}", path->string());
+}
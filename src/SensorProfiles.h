@@ -0,0 +1,54 @@
+#pragma once
+
+#include "PCH.h"
+#include "Settings.h"
+#include <vector>
+
+// Picks the [Profile:<Name>] that fits the player's surroundings.
+// Selection only runs when the player changes cell or worldspace. The most
+// specific matching profile wins: a location keyword beats a worldspace,
+// which beats the interior/exterior rule. Rays cast per frame are tallied
+// per profile for the report.
+class SensorProfiles {
+public:
+  using Profile = Settings::SensorProfile;
+  static constexpr std::uint32_t NONE = 0xFFFFFFFF;
+
+  static SensorProfiles *GetSingleton() {
+    static SensorProfiles singleton;
+    return &singleton;
+  }
+
+  void Load(const std::vector<Profile> &a_profiles);
+
+  // Index of the best profile for a_actor's cell, worldspace and location
+  std::uint32_t Select(RE::Actor *a_actor) const;
+  const Profile &Get(std::uint32_t a_index) const { return _profiles[a_index]; }
+
+  // Main thread, once per player update
+  void AddFrame(std::uint32_t a_index, std::uint64_t a_rays,
+                std::uint64_t a_avoided);
+  void AddSwitch(std::uint32_t a_index) { ++_stats[a_index].switches; }
+
+  // Writes RaySense_Profiles.txt to the SKSE log folder
+  void WriteReport() const;
+
+private:
+  struct Stats {
+    std::uint64_t frames{0};
+    std::uint64_t rays{0};
+    std::uint64_t maxRays{0};
+    std::uint64_t avoided{0}; // Answered by the character controller
+    std::uint64_t switches{0};
+  };
+
+  SensorProfiles() = default;
+  ~SensorProfiles() = default;
+  SensorProfiles(const SensorProfiles &) = delete;
+  SensorProfiles(const SensorProfiles &&) = delete;
+  SensorProfiles &operator=(const SensorProfiles &) = delete;
+  SensorProfiles &operator=(const SensorProfiles &&) = delete;
+
+  std::vector<Profile> _profiles{Profile{}};
+  std::vector<Stats> _stats{Stats{}};
+};
@@ -0,0 +1,266 @@
+#include "Settings.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+constexpr auto SETTINGS_PATH =
+    "Data/SKSE/Plugins/OpenAnimationReplacer-RaySense.ini"sv;
+
+std::string Trim(const std::string &a_str) {
+  auto begin = a_str.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos)
+    return {};
+  auto end = a_str.find_last_not_of(" \t\r\n");
+  return a_str.substr(begin, end - begin + 1);
+}
+
+std::string ToLower(std::string a_str) {
+  std::transform(
+      a_str.begin(), a_str.end(), a_str.begin(),
+      [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return a_str;
+}
+
+// Comma-separated items, trimmed, empty ones dropped
+std::vector<std::string> SplitList(const std::string &a_str) {
+  std::vector<std::string> items;
+  std::size_t start = 0;
+  while (start <= a_str.size()) {
+    auto end = a_str.find(',', start);
+    if (end == std::string::npos)
+      end = a_str.size();
+    if (auto item = Trim(a_str.substr(start, end - start)); !item.empty())
+      items.push_back(std::move(item));
+    start = end + 1;
+  }
+  return items;
+}
+} // namespace
+
+void Settings::Load() {
+  _values.clear();
+
+  std::ifstream file{std::string(SETTINGS_PATH)};
+  if (!file.is_open()) {
+    SKSE::log::info("Settings: {} not found, using defaults", SETTINGS_PATH);
+  } else {
+    std::string line;
+    std::string section;
+    while (std::getline(file, line)) {
+      if (auto comment = line.find_first_of(";#");
+          comment != std::string::npos)
+        line.erase(comment);
+      line = Trim(line);
+      if (line.empty())
+        continue;
+
+      if (line.front() == '[' && line.back() == ']') {
+        section = ToLower(Trim(line.substr(1, line.size() - 2)));
+        continue;
+      }
+
+      auto eq = line.find('=');
+      if (eq == std::string::npos)
+        continue;
+      _values[section + "." + ToLower(Trim(line.substr(0, eq)))] =
+          Trim(line.substr(eq + 1));
+    }
+  }
+
+  traceEnabled = GetBool("trace.benabled", traceEnabled);
+  traceBufferEvents = std::clamp(
+      GetUInt("trace.ibufferevents", traceBufferEvents), 256u, 1u << 20);
+  traceDumpSeconds =
+      std::max(0.1f, GetFloat("trace.fdumpseconds", traceDumpSeconds));
+  traceDumpHotkey = GetUInt("trace.idumphotkey", traceDumpHotkey);
+  traceSpikeThresholdMs =
+      GetFloat("trace.fspikethresholdms", traceSpikeThresholdMs);
+
+  conditionProfilerEnabled =
+      GetBool("profiler.bconditionprofiler", conditionProfilerEnabled);
+  reportHotkey = GetUInt("profiler.ireporthotkey", reportHotkey);
+
+  animationThrashEnabled =
+      GetBool("telemetry.banimationthrash", animationThrashEnabled);
+  animationSampleInterval =
+      GetFloat("telemetry.fsampleinterval", animationSampleInterval);
+
+  heatmapEnabled = GetBool("heatmap.benabled", heatmapEnabled);
+  heatmapTileSize = GetFloat("heatmap.ftilesize", heatmapTileSize);
+
+  actorSensingEnabled = GetBool("actors.benabled", actorSensingEnabled);
+  actorTTL = GetFloat("actors.fttl", actorTTL);
+  actorDistanceScale = GetFloat("actors.fdistancescale", actorDistanceScale);
+  actorMaxPerFrame = GetUInt("actors.imaxperframe", actorMaxPerFrame);
+  actorIdleSeconds = GetFloat("actors.fidleseconds", actorIdleSeconds);
+
+  sensorBudgetUs = GetFloat("governor.fbudgetus", sensorBudgetUs);
+
+  sensorTickHz = GetFloat("tick.fhz", sensorTickHz);
+  tickMidairFullRate = GetBool("tick.bmidairfullrate", tickMidairFullRate);
+
+  landingMaxSegments =
+      std::clamp(GetUInt("landing.imaxsegments", landingMaxSegments), 1u, 16u);
+  landingSegmentLength = std::max(
+      25.0f, GetFloat("landing.fsegmentlength", landingSegmentLength));
+
+  supersampleFrames = std::clamp(
+      GetUInt("supersample.iframes", supersampleFrames), 1u, 8u);
+  supersampleRadius =
+      std::max(1.0f, GetFloat("supersample.fradius", supersampleRadius));
+
+  arrayDirections = GetUInt("array.idirections", arrayDirections);
+  if (auto heights = SplitList(GetString("array.sheights", {}));
+      !heights.empty()) {
+    arrayHeights.clear();
+    for (const auto &item : heights) {
+      char *end = nullptr;
+      const float height = std::strtof(item.c_str(), &end);
+      if (end != item.c_str() && std::isfinite(height))
+        arrayHeights.push_back(height);
+    }
+  }
+  arrayReach = std::max(10.0f, GetFloat("array.freach", arrayReach));
+  arrayBackReach =
+      std::max(10.0f, GetFloat("array.fbackreach", arrayReach));
+
+  lookaheadReactionTime = std::max(
+      0.0f, GetFloat("lookahead.freactiontime", lookaheadReactionTime));
+  lookaheadMinOffset = std::max(
+      0.0f, GetFloat("lookahead.fminoffset", lookaheadMinOffset));
+  lookaheadMaxOffset = std::max(
+      lookaheadMinOffset,
+      GetFloat("lookahead.fmaxoffset", lookaheadMaxOffset));
+  lookaheadMinReach = std::max(
+      10.0f, GetFloat("lookahead.fminreach", lookaheadMinReach));
+
+  sampleFirst = GetBool("latency.bsamplefirst", sampleFirst);
+  latencyMeasure = GetBool("latency.bmeasure", latencyMeasure);
+
+  sensorThreads = GetUInt("pool.ithreads", sensorThreads);
+
+  surfaceFootstepEvents =
+      GetBool("surface.bfootstepevents", surfaceFootstepEvents);
+  surfaceFallbackHz = GetFloat("surface.ffallbackhz", surfaceFallbackHz);
+
+  classifyKeywords = SplitList(GetString("classify.skeywords", {}));
+
+  LoadProfiles();
+  LoadSuppressRules();
+
+  SKSE::log::info("Settings: Loaded {} values (Trace: {})", _values.size(),
+                  traceEnabled);
+}
+
+void Settings::LoadProfiles() {
+  constexpr auto PREFIX = "profile:"sv;
+
+  // Built-ins first so a [Profile:Interior] section overrides them
+  std::vector<std::string> names{"interior", "exterior"};
+  for (const auto &[key, value] : _values) {
+    if (!key.starts_with(PREFIX))
+      continue;
+    auto name = key.substr(PREFIX.size(), key.find('.') - PREFIX.size());
+    if (std::find(names.begin(), names.end(), name) == names.end())
+      names.push_back(name);
+  }
+  std::sort(names.begin() + 2, names.end());
+
+  profiles.clear();
+  for (const auto &name : names) {
+    const auto section = std::string(PREFIX) + name + ".";
+    SensorProfile profile;
+    profile.name = name;
+    profile.interior = name == "interior" ? 1 : name == "exterior" ? 0 : -1;
+    if (_values.contains(section + "binterior"))
+      profile.interior = GetBool(section + "binterior", false) ? 1 : 0;
+    profile.worldspace = ToLower(GetString(section + "sworldspace", {}));
+    profile.locationKeyword = GetString(section + "slocationkeyword", {});
+
+    profile.dropLength = std::clamp(
+        GetFloat(section + "fdroplength", profile.dropLength), 200.0f,
+        20000.0f);
+    profile.obstacleReach = std::max(
+        10.0f, GetFloat(section + "fobstaclereach", profile.obstacleReach));
+    profile.sprintObstacleReach =
+        std::max(10.0f, GetFloat(section + "fsprintobstaclereach",
+                                 profile.sprintObstacleReach));
+    profile.typeReach =
+        std::max(10.0f, GetFloat(section + "ftypereach", profile.typeReach));
+    profile.tickHz = GetFloat(section + "ftickhz", profile.tickHz);
+
+    // Comma-separated channel names as listed in the README, or "All"
+    profile.channels = ParseChannels(GetString(section + "schannels", "all"));
+
+    profiles.push_back(std::move(profile));
+  }
+}
+
+void Settings::LoadSuppressRules() {
+  constexpr auto PREFIX = "suppress:"sv;
+
+  std::vector<std::string> names;
+  for (const auto &[key, value] : _values) {
+    if (!key.starts_with(PREFIX))
+      continue;
+    auto name = key.substr(PREFIX.size(), key.find('.') - PREFIX.size());
+    if (std::find(names.begin(), names.end(), name) == names.end())
+      names.push_back(name);
+  }
+  // First match wins, so the order must not depend on the hash map
+  std::sort(names.begin(), names.end());
+
+  suppressRules.clear();
+  for (const auto &name : names) {
+    const auto section = std::string(PREFIX) + name + ".";
+    SuppressRule rule;
+    rule.name = name;
+    rule.mod = GetString(section + "smod", {});
+    rule.subMod = GetString(section + "ssubmod", {});
+    rule.path = GetString(section + "spath", {});
+    rule.channels = ParseChannels(GetString(
+        section + "schannels",
+        "Obstacle, WallFront, WallFrontL, WallFrontR, WallLeft, WallRight"));
+    rule.hz = std::max(0.0f, GetFloat(section + "fhz", rule.hz));
+    if (rule.channels)
+      suppressRules.push_back(std::move(rule));
+  }
+}
+
+bool Settings::GetBool(const std::string &a_key, bool a_default) const {
+  auto it = _values.find(a_key);
+  if (it == _values.end())
+    return a_default;
+  auto value = ToLower(it->second);
+  return value == "1" || value == "true" || value == "on";
+}
+
+float Settings::GetFloat(const std::string &a_key, float a_default) const {
+  auto it = _values.find(a_key);
+  if (it == _values.end())
+    return a_default;
+  char *end = nullptr;
+  float value = std::strtof(it->second.c_str(), &end);
+  return (end != it->second.c_str() && std::isfinite(value)) ? value
+                                                             : a_default;
+}
+
+std::string Settings::GetString(const std::string &a_key,
+                                const std::string &a_default) const {
+  auto it = _values.find(a_key);
+  return it != _values.end() ? it->second : a_default;
+}
+
+std::uint32_t Settings::GetUInt(const std::string &a_key,
+                                std::uint32_t a_default) const {
+  auto it = _values.find(a_key);
+  if (it == _values.end())
+    return a_default;
+  char *end = nullptr;
+  // Base 0 so hotkeys can be written as hex (0x58) or decimal (88)
+  auto value = std::strtoul(it->second.c_str(), &end, 0);
+  return end != it->second.c_str() ? static_cast<std::uint32_t>(value)
+                                   : a_default;
+}
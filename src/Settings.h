@@ -0,0 +1,141 @@
+#pragma once
+
+#include "PCH.h"
+#include "SensorChannels.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Runtime configuration loaded from
+// Data/SKSE/Plugins/OpenAnimationReplacer-RaySense.ini
+// Every value has a default, so a missing file or key keeps stock behavior.
+class Settings {
+public:
+  static Settings *GetSingleton() {
+    static Settings singleton;
+    return &singleton;
+  }
+
+  void Load();
+
+  // [Trace]
+  bool traceEnabled{false};
+  std::uint32_t traceBufferEvents{16384}; // Per-thread ring buffer capacity
+  float traceDumpSeconds{5.0f};           // Window written by a dump
+  std::uint32_t traceDumpHotkey{0};       // DirectInput scan code, 0 = off
+  float traceSpikeThresholdMs{0.0f};      // Auto-dump above this, 0 = off
+
+  // [Profiler]
+  bool conditionProfilerEnabled{false};
+  std::uint32_t reportHotkey{0}; // Writes profiler reports, 0 = off
+
+  // [Telemetry]
+  bool animationThrashEnabled{false};
+  float animationSampleInterval{0.1f}; // Seconds between OAR queries
+
+  // [Heatmap]
+  bool heatmapEnabled{false};
+  float heatmapTileSize{1024.0f}; // Exterior grid tile edge in game units
+
+  // [Actors]
+  bool actorSensingEnabled{false}; // Opt-in; packs enable it in [Actors]
+  float actorTTL{0.1f};              // Seconds between refreshes up close
+  float actorDistanceScale{2048.0f}; // TTL grows by 1x per this many units
+  std::uint32_t actorMaxPerFrame{4}; // Actors sensed per player update
+  float actorIdleSeconds{5.0f};      // Evict when no condition reads this long
+
+  // [Governor]
+  float sensorBudgetUs{0.0f}; // Player sensing per frame, 0 = unlimited
+
+  // [Tick]
+  float sensorTickHz{0.0f};      // Player sensing rate, 0 = every frame
+  bool tickMidairFullRate{true}; // Landing prediction ignores the tick
+
+  // [Landing]
+  std::uint32_t landingMaxSegments{6}; // Arc rays per landing prediction
+  float landingSegmentLength{150.0f};  // Arc length one ray should cover
+
+  // [Supersample]
+  std::uint32_t supersampleFrames{1}; // Rays kept per channel, 1 = off
+  float supersampleRadius{12.0f};     // Jitter around the nominal ray
+
+  // [Array]
+  // Rings of rays around the player, one per direction at each height
+  std::uint32_t arrayDirections{0};               // 4, 8 or 16, 0 = off
+  std::vector<float> arrayHeights{40.0f, 100.0f}; // Above the feet, up to 4
+  float arrayReach{200.0f};     // Straight ahead
+  float arrayBackReach{200.0f}; // Straight behind, blended in between
+
+  // [Lookahead]
+  float lookaheadReactionTime{0.0f}; // Seconds of warning, 0 = fixed offsets
+  float lookaheadMinOffset{40.0f};   // Front drop sensor offset bounds
+  float lookaheadMaxOffset{400.0f};
+  float lookaheadMinReach{120.0f}; // Obstacle and front wall ray floor
+
+  // [Latency]
+  bool sampleFirst{false};    // Sense before the player update, not after
+  bool latencyMeasure{false}; // Histogram of sample age at condition reads
+
+  // [Pool]
+  std::uint32_t sensorThreads{0}; // Experimental; 0/1 = main thread only
+
+  // [Surface]
+  bool surfaceFootstepEvents{true}; // Sample the player's surface on footfalls
+  float surfaceFallbackHz{4.0f};    // Between footfalls, 0 = every tick
+
+  // [Classify]
+  // Keyword editor IDs recorded for every hit reference (up to 32)
+  std::vector<std::string> classifyKeywords;
+
+  // [Profile:<Name>]
+  // Ray lengths, channels and rate for a kind of place. Interior and
+  // Exterior always exist; defaults match the built-in sensor values.
+  struct SensorProfile {
+    std::string name;
+    // Match rules, unset ones match anything
+    int interior{-1};            // 1 = interiors, 0 = exteriors, -1 = both
+    std::string worldspace;      // Worldspace editor ID
+    std::string locationKeyword; // Keyword editor ID on the current location
+
+    float dropLength{5000.0f};   // Verticality rays, from 100 units up
+    float obstacleReach{230.0f}; // Obstacle and wall rays
+    float sprintObstacleReach{330.0f};
+    float typeReach{250.0f}; // Obstacle type rays
+    ChannelMask channels{ALL_CHANNELS};
+    float tickHz{-1.0f}; // < 0 = [Tick] fHz
+  };
+  std::vector<SensorProfile> profiles;
+
+  // [Suppress:<Name>]
+  // Channels held while the player plays a matching replacement clip.
+  // Patterns are case-insensitive with * and ?; empty ones match anything.
+  struct SuppressRule {
+    std::string name;
+    std::string mod;
+    std::string subMod;
+    std::string path; // Replacement animation path
+    ChannelMask channels{0};
+    float hz{0.0f}; // Samples per second while held, 0 = frozen
+  };
+  std::vector<SuppressRule> suppressRules;
+
+private:
+  Settings() = default;
+  ~Settings() = default;
+  Settings(const Settings &) = delete;
+  Settings(const Settings &&) = delete;
+  Settings &operator=(const Settings &) = delete;
+  Settings &operator=(const Settings &&) = delete;
+
+  bool GetBool(const std::string &a_key, bool a_default) const;
+  float GetFloat(const std::string &a_key, float a_default) const;
+  std::uint32_t GetUInt(const std::string &a_key, std::uint32_t a_default) const;
+  std::string GetString(const std::string &a_key,
+                        const std::string &a_default) const;
+
+  void LoadProfiles();
+  void LoadSuppressRules();
+
+  // "section.key" (lower case) -> raw value
+  std::unordered_map<std::string, std::string> _values;
+};
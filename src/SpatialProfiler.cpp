@@ -0,0 +1,84 @@
+#include "SpatialProfiler.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
+
+void SpatialProfiler::Configure(bool a_enabled, float a_tileSize) {
+  _tileSize = std::max(128.0f, a_tileSize);
+  _sessionId = std::chrono::duration_cast<std::chrono::seconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+                   .count();
+  _enabled.store(a_enabled, std::memory_order_relaxed);
+
+  if (a_enabled) {
+    SKSE::log::info("SpatialProfiler: Enabled (tile size {:.0f})", _tileSize);
+  }
+}
+
+void SpatialProfiler::OnFrameEnd(RE::PlayerCharacter *a_player,
+                                 std::int64_t a_durationNs) {
+  const auto rays = _frameRays.exchange(0, std::memory_order_relaxed);
+  const auto fallbacks =
+      _frameFallbacks.exchange(0, std::memory_order_relaxed);
+  const auto lockWaitNs =
+      _frameLockWaitNs.exchange(0, std::memory_order_relaxed);
+
+  if (!a_player)
+    return;
+
+  auto *cell = a_player->GetParentCell();
+  if (!cell)
+    return;
+
+  const bool interior = cell->IsInteriorCell();
+  const auto pos = a_player->GetPosition();
+
+  Key key{};
+  key.cell = cell->GetFormID();
+  if (auto *worldSpace = a_player->GetWorldspace())
+    key.worldSpace = worldSpace->GetFormID();
+  if (!interior && std::isfinite(pos.x) && std::isfinite(pos.y)) {
+    key.tileX = static_cast<std::int32_t>(std::floor(pos.x / _tileSize));
+    key.tileY = static_cast<std::int32_t>(std::floor(pos.y / _tileSize));
+  }
+
+  auto &stats = _stats[key];
+  const auto duration =
+      static_cast<std::uint64_t>(std::max<std::int64_t>(0, a_durationNs));
+  ++stats.frames;
+  stats.totalNs += duration;
+  stats.maxNs = std::max(stats.maxNs, duration);
+  stats.rays += rays;
+  stats.fallbacks += fallbacks;
+  stats.lockWaitNs +=
+      static_cast<std::uint64_t>(std::max<std::int64_t>(0, lockWaitNs));
+  stats.interior = interior;
+}
+
+bool SpatialProfiler::WriteReport() {
+  auto path = SKSE::log::log_directory();
+  if (!path)
+    return false;
+
+  // One file per session, rewritten with cumulative totals on every flush.
+  *path /= std::format("RaySense_Heatmap_{}.csv", _sessionId);
+  std::ofstream file(*path);
+  if (!file.is_open()) {
+    SKSE::log::error("SpatialProfiler: Failed to open {}", path->string());
+    return false;
+  }
+
+  file << "worldspace,cell,tile_x,tile_y,interior,frames,total_us,max_us,"
+          "rays,fallbacks,lock_wait_us\n";
+  for (const auto &[key, stats] : _stats) {
+    file << std::format("{:08X},{:08X},{},{},{},{},{},{},{},{},{}\n",
+                        key.worldSpace, key.cell, key.tileX, key.tileY,
+                        stats.interior ? 1 : 0, stats.frames,
+                        stats.totalNs / 1000, stats.maxNs / 1000, stats.rays,
+                        stats.fallbacks, stats.lockWaitNs / 1000);
+  }
+
+  SKSE::log::info("SpatialProfiler: Wrote {} locations to {}", _stats.size(),
+                  path->string());
+  return true;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "PCH.h"
+#include <atomic>
+#include <unordered_map>
+
+// Spatial cost heatmap.
+// Accumulates sensing cost per worldspace, cell and grid tile so locations
+// with dense collision can be found and tuned. Results are written as CSV
+// (RaySense_Heatmap_*.csv) and can be merged across sessions with
+// tools/raysense-heatmap.
+class SpatialProfiler {
+public:
+  static SpatialProfiler *GetSingleton() {
+    static SpatialProfiler singleton;
+    return &singleton;
+  }
+
+  static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+  void Configure(bool a_enabled, float a_tileSize);
+
+  // Called for every ray cast, possibly from worker threads.
+  void AddRay(std::int64_t a_lockWaitNs) {
+    _frameRays.fetch_add(1, std::memory_order_relaxed);
+    _frameLockWaitNs.fetch_add(a_lockWaitNs, std::memory_order_relaxed);
+  }
+  // A sensor fell back to engine data or a default value because its ray
+  // could not be verified (no Havok world, teleport-sized velocity).
+  void AddFallback() {
+    _frameFallbacks.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Folds the counters of the finished OnUpdate into the player's location.
+  void OnFrameEnd(RE::PlayerCharacter *a_player, std::int64_t a_durationNs);
+
+  bool WriteReport();
+
+private:
+  struct Key {
+    RE::FormID worldSpace;
+    RE::FormID cell;
+    std::int32_t tileX;
+    std::int32_t tileY;
+    bool operator==(const Key &a_rhs) const = default;
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key &a_key) const {
+      std::size_t hash = a_key.worldSpace;
+      hash = hash * 31 + a_key.cell;
+      hash = hash * 31 + static_cast<std::uint32_t>(a_key.tileX);
+      return hash * 31 + static_cast<std::uint32_t>(a_key.tileY);
+    }
+  };
+  struct Stats {
+    std::uint64_t frames{0};
+    std::uint64_t totalNs{0};
+    std::uint64_t maxNs{0};
+    std::uint64_t rays{0};
+    std::uint64_t fallbacks{0};
+    std::uint64_t lockWaitNs{0};
+    bool interior{false};
+  };
+
+  SpatialProfiler() = default;
+  ~SpatialProfiler() = default;
+  SpatialProfiler(const SpatialProfiler &) = delete;
+  SpatialProfiler(const SpatialProfiler &&) = delete;
+  SpatialProfiler &operator=(const SpatialProfiler &) = delete;
+  SpatialProfiler &operator=(const SpatialProfiler &&) = delete;
+
+  static inline std::atomic<bool> _enabled{false};
+  float _tileSize{1024.0f};
+  std::int64_t _sessionId{0};
+
+  std::atomic<std::uint64_t> _frameRays{0};
+  std::atomic<std::uint64_t> _frameFallbacks{0};
+  std::atomic<std::int64_t> _frameLockWaitNs{0};
+
+  // Main thread only
+  std::unordered_map<Key, Stats, KeyHash> _stats;
+};
@@ -0,0 +1,38 @@
+#include "TemporalSampler.h"
+
+void TemporalSampler::Configure(std::uint32_t a_frames, std::uint32_t a_phase) {
+  _frames = std::clamp<std::uint32_t>(a_frames, 1, MAX_FRAMES);
+  _next = a_phase % _frames;
+  Clear();
+}
+
+void TemporalSampler::Clear() {
+  _count = 0;
+  _head = 0;
+}
+
+void TemporalSampler::NextOffset(float &a_u, float &a_v) {
+  // [Vogel Disk]
+  // Point i sits at radius sqrt((i + 0.5) / n), turned by the golden angle
+  // from the previous one: every ring of the disk gets one point, and
+  // consecutive points land on opposite sides.
+  constexpr float GOLDEN_ANGLE = 2.39996323f;
+  const std::uint32_t index = _next;
+  _next = (_next + 1) % _frames;
+
+  if (_frames == 1) {
+    a_u = a_v = 0.0f; // A single frame keeps the nominal ray
+    return;
+  }
+  const float radius = std::sqrt((static_cast<float>(index) + 0.5f) /
+                                 static_cast<float>(_frames));
+  const float angle = GOLDEN_ANGLE * static_cast<float>(index);
+  a_u = radius * std::cos(angle);
+  a_v = radius * std::sin(angle);
+}
+
+void TemporalSampler::Push(const Sample &a_sample) {
+  _samples[_head] = a_sample;
+  _head = (_head + 1) % _frames;
+  _count = std::min(_count + 1, _frames);
+}
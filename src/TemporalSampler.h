@@ -0,0 +1,79 @@
+#pragma once
+
+// Kept free of game headers so host tools can replay sample histories.
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Rotating-pattern supersampling for one channel.
+// Each sense casts a single ray nudged by the next offset of a small
+// stratified disk pattern, and the last few rays are kept in world space.
+// Combine() re-measures every kept ray from where the sensor is now, drops
+// the ones that no longer cover it, and publishes their median, so K frames
+// give K-ray robustness at one ray per frame. The spread of the kept values
+// is a free roughness estimate.
+class TemporalSampler {
+public:
+  static constexpr std::uint32_t MAX_FRAMES = 8;
+
+  struct Point {
+    float x{0.0f};
+    float y{0.0f};
+    float z{0.0f};
+  };
+
+  struct Sample {
+    Point start; // Jittered ray start
+    Point point; // Hit, or the ray end on a miss
+    bool hit{false};
+  };
+
+  // Keeps a_frames samples (clamped to 1..MAX_FRAMES) and starts the pattern
+  // at a_phase, so channels sensed together do not jitter in lockstep.
+  void Configure(std::uint32_t a_frames, std::uint32_t a_phase);
+  void Clear();
+
+  // Next offset on the unit disk. a_frames consecutive calls cover one
+  // pattern of a_frames points spread by the golden angle.
+  void NextOffset(float &a_u, float &a_v);
+
+  void Push(const Sample &a_sample);
+
+  // a_measure(sample, value) re-measures a kept sample against the current
+  // ray and returns false to drop it. Writes the median and standard
+  // deviation of what was kept; false when nothing was.
+  template <class MeasureFn>
+  bool Combine(MeasureFn &&a_measure, float &a_value, float &a_spread) const {
+    std::array<float, MAX_FRAMES> values{};
+    std::uint32_t kept = 0;
+    for (std::uint32_t i = 0; i < _count; ++i) {
+      if (a_measure(_samples[i], values[kept]))
+        ++kept;
+    }
+    if (kept == 0)
+      return false;
+
+    std::sort(values.begin(), values.begin() + kept);
+    const std::uint32_t mid = kept / 2;
+    a_value = kept % 2 ? values[mid] : 0.5f * (values[mid - 1] + values[mid]);
+
+    float mean = 0.0f;
+    for (std::uint32_t i = 0; i < kept; ++i)
+      mean += values[i];
+    mean /= static_cast<float>(kept);
+    float variance = 0.0f;
+    for (std::uint32_t i = 0; i < kept; ++i)
+      variance += (values[i] - mean) * (values[i] - mean);
+    a_spread = std::sqrt(variance / static_cast<float>(kept));
+    return true;
+  }
+
+private:
+  std::array<Sample, MAX_FRAMES> _samples{};
+  std::uint32_t _frames{1};
+  std::uint32_t _count{0};
+  std::uint32_t _head{0}; // Slot the next sample overwrites
+  std::uint32_t _next{0}; // Pattern index of the next offset
+};
@@ -0,0 +1,160 @@
+#include "Trace.h"
+#include "Settings.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <thread>
+
+void Trace::Configure(bool a_enabled, std::uint32_t a_capacity) {
+  {
+    std::scoped_lock lock(_buffersLock);
+    _capacity = a_capacity;
+  }
+  _enabled.store(a_enabled, std::memory_order_relaxed);
+
+  if (a_enabled) {
+    SKSE::log::info("Trace: Enabled ({} events per thread)", a_capacity);
+  }
+}
+
+Trace::ThreadBuffer *Trace::AcquireThreadBuffer() {
+  thread_local ThreadBuffer *buffer = nullptr;
+  if (buffer)
+    return buffer;
+
+  // Buffers are never freed: game threads live for the whole session, and a
+  // dump may still be reading a buffer after its thread stopped writing.
+  std::scoped_lock lock(_buffersLock);
+  auto owned = std::make_unique<ThreadBuffer>();
+  owned->threadIndex = static_cast<std::uint32_t>(_buffers.size()) + 1;
+  owned->capacity = std::max<std::uint64_t>(_capacity, 1);
+  owned->slots = std::make_unique<Slot[]>(owned->capacity);
+  buffer = owned.get();
+  _buffers.push_back(std::move(owned));
+  return buffer;
+}
+
+void Trace::Record(const char *a_name, std::int64_t a_start,
+                   std::int64_t a_end) {
+  auto *buffer = AcquireThreadBuffer();
+  auto head = buffer->head.load(std::memory_order_relaxed);
+  auto &slot = buffer->slots[head % buffer->capacity];
+
+  // [Seqlock] Odd while the fields change; the fence keeps the field writes
+  // after it
+  slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(a_name, std::memory_order_relaxed);
+  slot.start.store(a_start, std::memory_order_relaxed);
+  slot.end.store(a_end, std::memory_order_relaxed);
+  slot.sequence.store(2 * head + 2, std::memory_order_release);
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+bool Trace::Dump(float a_seconds) {
+  auto path = SKSE::log::log_directory();
+  if (!path)
+    return false;
+
+  if (_writing.exchange(true, std::memory_order_acquire)) {
+    SKSE::log::warn("Trace: Previous dump still being written, skipped");
+    return false;
+  }
+
+  Capture capture;
+  capture.now = Now();
+  capture.windowStart =
+      capture.now - static_cast<std::int64_t>(a_seconds * 1'000'000'000.0);
+  capture.seconds = a_seconds;
+
+  {
+    std::scoped_lock lock(_buffersLock);
+    for (const auto &buffer : _buffers) {
+      const auto size = buffer->capacity;
+      const auto head = buffer->head.load(std::memory_order_acquire);
+      const auto available = std::min(head, size);
+
+      for (auto i = head - available; i < head; ++i) {
+        const auto &slot = buffer->slots[i % size];
+        // Skip slots the writer started on (or lapped) since head was read
+        const auto expected = 2 * i + 2;
+        if (slot.sequence.load(std::memory_order_acquire) != expected) {
+          ++capture.torn;
+          continue;
+        }
+        const Event event{slot.name.load(std::memory_order_relaxed),
+                          slot.start.load(std::memory_order_relaxed),
+                          slot.end.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+          ++capture.torn;
+          continue;
+        }
+        if (event.name && event.end >= capture.windowStart) {
+          capture.rows.push_back({event, buffer->threadIndex});
+        }
+      }
+    }
+  }
+
+  // Names are string literals, so the copy stays valid on the writer thread
+  std::thread([this, directory = std::move(*path),
+               capture = std::move(capture)]() mutable {
+    Write(directory, capture);
+    _writing.store(false, std::memory_order_release);
+  }).detach();
+  return true;
+}
+
+void Trace::Write(const std::filesystem::path &a_directory,
+                  Capture &a_capture) {
+  auto &rows = a_capture.rows;
+  std::sort(rows.begin(), rows.end(), [](const Row &a_lhs, const Row &a_rhs) {
+    return a_lhs.event.start < a_rhs.event.start;
+  });
+
+  const auto path = a_directory / std::format("RaySense_Trace_{}.json",
+                                              a_capture.now / 1'000'000);
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    SKSE::log::error("Trace: Failed to open {}", path.string());
+    return;
+  }
+
+  // Chrome trace-event format: complete events ("X") in microseconds.
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+          "\"args\":{\"name\":\"RaySense\"}}";
+  for (const auto &row : rows) {
+    file << std::format(",\n{{\"name\":\"{}\",\"cat\":\"RaySense\","
+                        "\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},"
+                        "\"dur\":{:.3f}}}",
+                        row.event.name, row.threadIndex,
+                        (row.event.start - a_capture.windowStart) / 1000.0,
+                        (row.event.end - row.event.start) / 1000.0);
+  }
+  file << "\n]}\n";
+
+  SKSE::log::info("Trace: Wrote {} events ({:.1f}s, {} overwritten while "
+                  "copying) to {}",
+                  rows.size(), a_capture.seconds, a_capture.torn,
+                  path.string());
+}
+
+void Trace::OnFrameEnd(std::int64_t a_start, std::int64_t a_end) {
+  if (!IsEnabled())
+    return;
+
+  const float thresholdMs = Settings::GetSingleton()->traceSpikeThresholdMs;
+  if (thresholdMs <= 0.0f)
+    return;
+
+  const float frameMs = (a_end - a_start) / 1'000'000.0f;
+  if (frameMs < thresholdMs || a_end - _lastSpikeDump < SPIKE_DUMP_COOLDOWN_NS)
+    return;
+
+  _lastSpikeDump = a_end;
+  SKSE::log::info("Trace: OnUpdate took {:.2f} ms (threshold {:.2f} ms)",
+                  frameMs, thresholdMs);
+  Dump(Settings::GetSingleton()->traceDumpSeconds);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "PCH.h"
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Frame timeline tracer.
+// Scoped markers are written into a fixed-size ring buffer owned by the
+// calling thread, so recording never takes a lock. A dump copies the last N
+// seconds of every buffer into a Chrome trace-event JSON file that can be
+// opened in chrome://tracing or ui.perfetto.dev.
+class Trace {
+public:
+  static Trace *GetSingleton() {
+    static Trace singleton;
+    return &singleton;
+  }
+
+  // RAII marker. Costs a single relaxed load while tracing is disabled.
+  class Scope {
+  public:
+    explicit Scope(const char *a_name)
+        : _name(IsEnabled() ? a_name : nullptr),
+          _start(_name ? Now() : 0) {}
+    ~Scope() {
+      if (_name)
+        GetSingleton()->Record(_name, _start, Now());
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    const char *_name;
+    std::int64_t _start;
+  };
+
+  void Configure(bool a_enabled, std::uint32_t a_capacity);
+  static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+  // a_name must point to a string literal; only the pointer is stored.
+  void Record(const char *a_name, std::int64_t a_start, std::int64_t a_end);
+  // Copies the last a_seconds of events and writes them on a background
+  // thread, so a dump never adds a sort and a file write to the frame that
+  // asked for it. Returns false if a previous dump is still being written.
+  bool Dump(float a_seconds);
+
+  // Writes a dump if a frame took longer than the configured threshold.
+  void OnFrameEnd(std::int64_t a_start, std::int64_t a_end);
+
+  static std::int64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+private:
+  struct Event {
+    const char *name;
+    std::int64_t start;
+    std::int64_t end;
+  };
+
+  struct Row {
+    Event event;
+    std::uint32_t threadIndex;
+  };
+
+  // Everything a background write needs, copied out of the ring buffers
+  struct Capture {
+    std::vector<Row> rows;
+    std::int64_t now{0};
+    std::int64_t windowStart{0};
+    float seconds{0.0f};
+    std::uint64_t torn{0};
+  };
+
+  // One ring buffer entry, read by dumps while its thread may be rewriting
+  // it. sequence is 2 * index + 1 while event index is being written and
+  // 2 * index + 2 once it is complete, so a reader keeps a copy only if the
+  // slot held that event both before and after copying it.
+  struct Slot {
+    std::atomic<std::uint64_t> sequence{0};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<std::int64_t> start{0};
+    std::atomic<std::int64_t> end{0};
+  };
+
+  struct ThreadBuffer {
+    std::uint32_t threadIndex{0};
+    std::uint64_t capacity{0};
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<std::uint64_t> head{0}; // Total events ever written
+  };
+
+  static constexpr std::int64_t SPIKE_DUMP_COOLDOWN_NS = 10'000'000'000;
+
+  Trace() = default;
+  ~Trace() = default;
+  Trace(const Trace &) = delete;
+  Trace(const Trace &&) = delete;
+  Trace &operator=(const Trace &) = delete;
+  Trace &operator=(const Trace &&) = delete;
+
+  ThreadBuffer *AcquireThreadBuffer();
+  static void Write(const std::filesystem::path &a_directory,
+                    Capture &a_capture);
+
+  static inline std::atomic<bool> _enabled{false};
+  std::uint32_t _capacity{16384};
+
+  std::mutex _buffersLock; // Guards registration and dumping only
+  std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+  std::int64_t _lastSpikeDump{0};
+  std::atomic<bool> _writing{false}; // A dump thread is still running
+};
@@ -0,0 +1,98 @@
+#include "WaterCache.h"
+#include <cmath>
+
+void WaterCache::Install() {
+  if (auto *events = RE::ScriptEventSourceHolder::GetSingleton()) {
+    events->AddEventSink<RE::TESCellAttachDetachEvent>(this);
+    SKSE::log::info("WaterCache: Registered cell attach/detach sink");
+  }
+}
+
+bool WaterCache::GetPlane(RE::TESObjectCELL *a_cell,
+                          const RE::NiPoint3 &a_pos, Plane &a_plane) {
+  if (!a_cell)
+    return false;
+
+  std::scoped_lock lock(_lock);
+  auto it = _planes.find(a_cell);
+  const bool cached =
+      it != _planes.end() && it->second.cell == a_cell->GetFormID();
+  const auto &entry = cached ? it->second : Fill(a_cell, a_pos);
+  if (entry.hasPlane)
+    a_plane = entry.plane;
+  return entry.hasPlane;
+}
+
+bool WaterCache::HasVolumes(const RE::TESObjectCELL *a_cell) const {
+  std::scoped_lock lock(_lock);
+  auto it = _volumes.find(a_cell);
+  return it != _volumes.end() && it->second > 0;
+}
+
+const WaterCache::Entry &WaterCache::Fill(RE::TESObjectCELL *a_cell,
+                                          const RE::NiPoint3 &a_pos) {
+  if (_planes.size() >= CAPACITY)
+    _planes.clear();
+
+  Entry entry;
+  entry.cell = a_cell->GetFormID();
+  // The engine reports cells without water with a huge sentinel height
+  constexpr float MAX_WATER_HEIGHT = 1.0e7f;
+  float height = 0.0f;
+  if (a_cell->cellFlags.all(RE::TESObjectCELL::Flag::kHasWater) &&
+      a_cell->GetWaterHeight(a_pos, height) && std::isfinite(height) &&
+      std::abs(height) < MAX_WATER_HEIGHT) {
+    entry.plane.height = height;
+    entry.hasPlane = true;
+  }
+  if (auto *waterType = a_cell->extraList.GetByType<RE::ExtraCellWaterType>())
+    entry.plane.form = waterType->water;
+
+  return _planes.insert_or_assign(a_cell, entry).first->second;
+}
+
+bool WaterCache::IsWaterVolume(RE::TESObjectREFR *a_ref) {
+  auto *base = a_ref->GetBaseObject();
+  auto *activator = base ? base->As<RE::TESObjectACTI>() : nullptr;
+  return activator && activator->waterForm;
+}
+
+void WaterCache::ClearPlanes() {
+  std::scoped_lock lock(_lock);
+  _planes.clear();
+}
+
+void WaterCache::Clear() {
+  std::scoped_lock lock(_lock);
+  _planes.clear();
+  _volumes.clear();
+}
+
+RE::BSEventNotifyControl WaterCache::ProcessEvent(
+    const RE::TESCellAttachDetachEvent *a_event,
+    RE::BSTEventSource<RE::TESCellAttachDetachEvent> *) {
+  if (!a_event || !a_event->reference)
+    return RE::BSEventNotifyControl::kContinue;
+
+  auto *ref = a_event->reference.get();
+  auto *cell = ref->GetParentCell();
+  if (!cell)
+    return RE::BSEventNotifyControl::kContinue;
+
+  std::scoped_lock lock(_lock);
+  if (a_event->attached) {
+    if (auto it = _planes.find(cell);
+        it == _planes.end() || it->second.cell != cell->GetFormID())
+      Fill(cell, ref->GetPosition());
+  }
+
+  if (IsWaterVolume(ref)) {
+    if (a_event->attached) {
+      ++_volumes[cell];
+    } else if (auto it = _volumes.find(cell);
+               it != _volumes.end() && --it->second == 0) {
+      _volumes.erase(it);
+    }
+  }
+  return RE::BSEventNotifyControl::kContinue;
+}
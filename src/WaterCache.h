@@ -0,0 +1,66 @@
+#pragma once
+
+#include "PCH.h"
+#include <mutex>
+#include <unordered_map>
+
+// Water known per loaded cell.
+// A cell's water plane height and water form are read once, the first time
+// one of its references attaches (or it is first queried), so wading depth
+// is a subtraction. Water volume references (activators with a water form:
+// rivers, waterfalls, pools) are counted per cell as they attach and
+// detach; only cells holding one need a water ray. Lookups may come from
+// graph threads (NPC resamples), so every access takes one lock.
+class WaterCache : public RE::BSTEventSink<RE::TESCellAttachDetachEvent> {
+public:
+  static WaterCache *GetSingleton() {
+    static WaterCache singleton;
+    return &singleton;
+  }
+
+  static constexpr std::size_t CAPACITY = 64;
+
+  struct Plane {
+    RE::TESWaterForm *form{nullptr}; // Null = worldspace default water
+    float height{0.0f};
+  };
+
+  void Install();
+
+  // Copies a_cell's water plane; false when it has none
+  bool GetPlane(RE::TESObjectCELL *a_cell, const RE::NiPoint3 &a_pos,
+                Plane &a_plane);
+  // True while a water volume reference is attached in a_cell
+  [[nodiscard]] bool HasVolumes(const RE::TESObjectCELL *a_cell) const;
+
+  // Drops cached planes; volume counts follow attach events (transitions)
+  void ClearPlanes();
+  // Drops everything (game load)
+  void Clear();
+
+  RE::BSEventNotifyControl ProcessEvent(
+      const RE::TESCellAttachDetachEvent *a_event,
+      RE::BSTEventSource<RE::TESCellAttachDetachEvent> *a_source) override;
+
+private:
+  WaterCache() = default;
+  ~WaterCache() = default;
+  WaterCache(const WaterCache &) = delete;
+  WaterCache(const WaterCache &&) = delete;
+  WaterCache &operator=(const WaterCache &) = delete;
+  WaterCache &operator=(const WaterCache &&) = delete;
+
+  struct Entry {
+    RE::FormID cell{0}; // Guards against a reused cell address
+    Plane plane;
+    bool hasPlane{false};
+  };
+
+  // Caller holds _lock
+  const Entry &Fill(RE::TESObjectCELL *a_cell, const RE::NiPoint3 &a_pos);
+  static bool IsWaterVolume(RE::TESObjectREFR *a_ref);
+
+  mutable std::mutex _lock; // Guards _planes and _volumes
+  std::unordered_map<const RE::TESObjectCELL *, Entry> _planes;
+  std::unordered_map<const RE::TESObjectCELL *, std::uint32_t> _volumes;
+};
@@ -1,6 +1,21 @@
+#include "ActorSensorCache.h"
+#include "AnimationTelemetry.h"
+#include "ClipSuppression.h"
+#include "ClipTracker.h"
+#include "CollidableCache.h"
+#include "ConditionProfiler.h"
 #include "Hooks.h"
+#include "InputHandler.h"
 #include "OARConditions.h"
+#include "OARFunctions.h"
 #include "RaySenseLogic.h"
+#include "SenseLatency.h"
+#include "SensingGate.h"
+#include "SensorProfiles.h"
+#include "Settings.h"
+#include "SpatialProfiler.h"
+#include "Trace.h"
+#include "WaterCache.h"
 #include <spdlog/sinks/basic_file_sink.h>
 
 using namespace std::literals;
@@ -102,10 +117,58 @@ SKSEPluginInfo(.Version = {1, 0, 0, 0},
         SKSE::log::info("RaySenseVerticality: Registered OAR Condition "
                         "'Obstacle_Type_Right'");
       }
+      if (OAR_API::Conditions::AddCustomCondition<
+              OARConditions::ArrayCondition>() ==
+          OAR_API::Conditions::APIResult::OK) {
+        SKSE::log::info("RaySenseVerticality: Registered OAR Condition "
+                        "'RaySense_Array'");
+      }
+
+      if (OAR_API::Functions::AddCustomFunction<
+              OARFunctions::ResampleFunction>() ==
+          OAR_API::Functions::APIResult::OK) {
+        SKSE::log::info("RaySenseVerticality: Registered OAR Function "
+                        "'RaySense_Resample'");
+      }
+      if (OAR_API::Functions::AddCustomFunction<
+              OARFunctions::AlignToHitFunction>() ==
+          OAR_API::Functions::APIResult::OK) {
+        SKSE::log::info("RaySenseVerticality: Registered OAR Function "
+                        "'RaySense_AlignToHit'");
+      }
+      if (OAR_API::Functions::AddCustomFunction<
+              OARFunctions::SetGraphVarsFromHitFunction>() ==
+          OAR_API::Functions::APIResult::OK) {
+        SKSE::log::info("RaySenseVerticality: Registered OAR Function "
+                        "'RaySense_SetGraphVarsFromHit'");
+      }
       break;
     case SKSE::MessagingInterface::kDataLoaded:
       RaySenseLogic::GetSingleton()->Install();
       Hooks::PlayerHook::Install();
+      InputHandler::GetSingleton()->Install();
+      SensingGate::GetSingleton()->Install();
+      WaterCache::GetSingleton()->Install();
+      CollidableCache::GetSingleton()->Install(
+          Settings::GetSingleton()->classifyKeywords);
+      break;
+    case SKSE::MessagingInterface::kSaveGame:
+      // SKSE has no reliable shutdown message; saving is the last point we
+      // can count on, so the heatmap is flushed with cumulative totals here.
+      if (SpatialProfiler::IsEnabled())
+        SpatialProfiler::GetSingleton()->WriteReport();
+      break;
+    case SKSE::MessagingInterface::kPreLoadGame:
+    case SKSE::MessagingInterface::kNewGame:
+      ClipTracker::GetSingleton()->Reset();
+      ActorSensorCache::GetSingleton()->Reset();
+      CollidableCache::GetSingleton()->Clear();
+      WaterCache::GetSingleton()->Clear();
+      if (a_msg->type == SKSE::MessagingInterface::kNewGame)
+        SensingGate::GetSingleton()->OnGameLoaded();
+      break;
+    case SKSE::MessagingInterface::kPostLoadGame:
+      SensingGate::GetSingleton()->OnGameLoaded();
       break;
     }
   }
@@ -117,6 +180,27 @@ SKSEPluginLoad(const SKSE::LoadInterface *a_skse) {
 
   SKSE::Init(a_skse);
 
+  auto *settings = Settings::GetSingleton();
+  settings->Load();
+  Trace::GetSingleton()->Configure(settings->traceEnabled,
+                                   settings->traceBufferEvents);
+  ConditionProfiler::GetSingleton()->SetEnabled(
+      settings->conditionProfilerEnabled);
+  AnimationTelemetry::GetSingleton()->Configure(
+      settings->animationThrashEnabled, settings->animationSampleInterval);
+  SpatialProfiler::GetSingleton()->Configure(settings->heatmapEnabled,
+                                             settings->heatmapTileSize);
+  ActorSensorCache::GetSingleton()->Configure(
+      settings->actorSensingEnabled, settings->actorTTL,
+      settings->actorDistanceScale, settings->actorMaxPerFrame,
+      settings->actorIdleSeconds);
+  SensorProfiles::GetSingleton()->Load(settings->profiles);
+  ClipSuppression::GetSingleton()->Configure(settings->suppressRules);
+  ClipTracker::GetSingleton()->Configure(AnimationTelemetry::IsEnabled() ||
+                                         ClipSuppression::IsEnabled());
+  SenseLatency::GetSingleton()->Configure(settings->latencyMeasure,
+                                          settings->sampleFirst);
+
   auto messaging = SKSE::GetMessagingInterface();
   if (messaging) {
     messaging->RegisterListener(OnMessaging);
@@ -0,0 +1,230 @@
+// raysense-actor-bench: multi-actor sensing scaling in a synthetic world.
+//
+// Drives the plugin's ActorSensorTable the way ActorSensorCache does: a
+// 60 Hz main thread drains requests, refreshes camera distances, picks due
+// actors and "senses" them (a busy wait per ray stands in for Havok), while
+// graph threads evaluate conditions for every actor. Each commit stores its
+// timestamp in a channel so readers can measure how stale their values are.
+//
+// Usage: raysense-actor-bench [--seconds S] [--actors 1,10,50,100,200]
+//                             [--budget 2,4,8] [--ray-us U] [--readers N]
+//                             [--ttl S] [--distance-scale D]
+
+#include "../../src/ActorSensorTable.h"
+#include "common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+using bench::Clock;
+using bench::ParseList;
+using bench::Seconds;
+using bench::Spin;
+
+// Worst-case rays per SenseActor pass: obstacles 6, types 3, verticality 4,
+// surface 1
+constexpr unsigned RAYS_PER_ACTOR = 14;
+constexpr double FRAME_SECONDS = 1.0 / 60.0;
+// Actors inside this camera distance count as "near" in the age columns
+constexpr float NEAR_DISTANCE = 1024.0f;
+
+struct Options {
+  double seconds{2.0};
+  std::vector<unsigned> actors{1, 10, 25, 50, 100, 200};
+  std::vector<unsigned> budgets{2, 4, 8};
+  double rayUs{3.0};
+  unsigned readers{2};
+  float ttl{0.1f};
+  float distanceScale{2048.0f};
+};
+
+struct Actor {
+  ActorSensorTable::Handle handle;
+  float distance;
+};
+
+struct Result {
+  double updateMeanUs{0.0};
+  double updateP99Us{0.0};
+  double updateMaxUs{0.0};
+  double sensedPerSecond{0.0};
+  double nearAgeMs{0.0};
+  double farAgeMs{0.0};
+  double readNs{0.0};
+  std::size_t dropped{0};
+};
+
+Result Run(const Options &a_options, unsigned a_actors, unsigned a_budget) {
+  // Scatter actors 100 to 8000 units from the camera
+  std::vector<Actor> world(a_actors);
+  std::mt19937 rng(a_actors * 7919u + a_budget);
+  std::uniform_real_distribution<float> distance(100.0f, 8000.0f);
+  for (unsigned i = 0; i < a_actors; ++i)
+    world[i] = {0x100000u + i, distance(rng)};
+
+  ActorSensorTable table;
+  const auto start = Clock::now();
+  std::atomic<bool> stop{false};
+  std::atomic<float> now{0.0f};
+
+  struct ReaderStats {
+    double nearAge{0.0};
+    double farAge{0.0};
+    std::uint64_t nearReads{0};
+    std::uint64_t farReads{0};
+    std::uint64_t reads{0};
+    double readSeconds{0.0};
+  };
+  std::vector<ReaderStats> readerStats(a_options.readers);
+  std::vector<std::thread> readers;
+  for (unsigned r = 0; r < a_options.readers; ++r) {
+    readers.emplace_back([&, r] {
+      auto &stats = readerStats[r];
+      while (!stop.load(std::memory_order_relaxed)) {
+        const auto passStart = Clock::now();
+        for (const auto &actor : world) {
+          float value = 0.0f;
+          if (table.Read(actor.handle, Channel::kFront, value)) {
+            const double age = now.load(std::memory_order_relaxed) - value;
+            if (actor.distance < NEAR_DISTANCE) {
+              stats.nearAge += age;
+              ++stats.nearReads;
+            } else {
+              stats.farAge += age;
+              ++stats.farReads;
+            }
+          }
+          ++stats.reads;
+        }
+        stats.readSeconds += Seconds(passStart);
+        // Graph updates are frame-paced too; don't flood the request queue
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }
+    });
+  }
+
+  std::vector<double> updateUs;
+  std::vector<std::uint32_t> due;
+  std::uint64_t sensed = 0;
+  auto nextFrame = start;
+  while (Seconds(start) < a_options.seconds) {
+    nextFrame += std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(FRAME_SECONDS));
+    const float frameNow = static_cast<float>(Seconds(start));
+    now.store(frameNow, std::memory_order_relaxed);
+
+    const auto updateStart = Clock::now();
+    table.BeginUpdate(frameNow);
+    table.EvictIdle(5.0f);
+    table.ForEach([&](std::uint32_t a_slot,
+                      ActorSensorTable::Handle a_handle) {
+      table.SetDistance(a_slot, world[a_handle - 0x100000u].distance);
+    });
+    table.SelectDue(a_options.ttl, a_options.distanceScale, a_budget, due);
+    for (auto slot : due) {
+      Spin(a_options.rayUs * RAYS_PER_ACTOR);
+      ActorSensorTable::Values values{};
+      values[ToIndex(Channel::kFront)] = frameNow;
+      table.Commit(slot, values);
+      ++sensed;
+    }
+    updateUs.push_back(
+        std::chrono::duration<double, std::micro>(Clock::now() - updateStart)
+            .count());
+
+    std::this_thread::sleep_until(nextFrame);
+  }
+
+  stop.store(true, std::memory_order_relaxed);
+  for (auto &reader : readers)
+    reader.join();
+
+  Result result;
+  std::sort(updateUs.begin(), updateUs.end());
+  for (auto us : updateUs)
+    result.updateMeanUs += us;
+  result.updateMeanUs /= std::max<std::size_t>(updateUs.size(), 1);
+  result.updateP99Us = updateUs[updateUs.size() * 99 / 100];
+  result.updateMaxUs = updateUs.back();
+  result.sensedPerSecond = sensed / a_options.seconds;
+  result.dropped = table.Dropped();
+
+  ReaderStats total;
+  for (const auto &stats : readerStats) {
+    total.nearAge += stats.nearAge;
+    total.farAge += stats.farAge;
+    total.nearReads += stats.nearReads;
+    total.farReads += stats.farReads;
+    total.reads += stats.reads;
+    total.readSeconds += stats.readSeconds;
+  }
+  result.nearAgeMs =
+      total.nearReads ? 1000.0 * total.nearAge / total.nearReads : 0.0;
+  result.farAgeMs =
+      total.farReads ? 1000.0 * total.farAge / total.farReads : 0.0;
+  result.readNs = total.reads ? 1e9 * total.readSeconds / total.reads : 0.0;
+  return result;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!std::strcmp(argv[i], "--seconds") && value) {
+      options.seconds = std::max(0.2, std::atof(value));
+      ++i;
+    } else if (!std::strcmp(argv[i], "--actors") && value) {
+      options.actors = ParseList(value);
+      ++i;
+    } else if (!std::strcmp(argv[i], "--budget") && value) {
+      options.budgets = ParseList(value);
+      ++i;
+    } else if (!std::strcmp(argv[i], "--ray-us") && value) {
+      options.rayUs = std::max(0.0, std::atof(value));
+      ++i;
+    } else if (!std::strcmp(argv[i], "--readers") && value) {
+      options.readers = std::max(1, std::atoi(value));
+      ++i;
+    } else if (!std::strcmp(argv[i], "--ttl") && value) {
+      options.ttl = static_cast<float>(std::max(0.0, std::atof(value)));
+      ++i;
+    } else if (!std::strcmp(argv[i], "--distance-scale") && value) {
+      options.distanceScale =
+          static_cast<float>(std::max(1.0, std::atof(value)));
+      ++i;
+    } else {
+      std::fprintf(stderr,
+                   "usage: raysense-actor-bench [--seconds S] "
+                   "[--actors 1,10,50,100,200] [--budget 2,4,8] [--ray-us U] "
+                   "[--readers N] [--ttl S] [--distance-scale D]\n");
+      return 2;
+    }
+  }
+
+  std::printf("%6s %6s %10s %9s %9s %9s %11s %11s %8s %7s\n", "Actors",
+              "Budget", "Upd avg us", "p99 us", "max us", "Sensed/s",
+              "Near age ms", "Far age ms", "Read ns", "Dropped");
+  for (auto budget : options.budgets) {
+    for (auto actors : options.actors) {
+      const auto result = Run(options, actors, budget);
+      std::printf("%6u %6u %10.1f %9.1f %9.1f %9.0f %11.1f %11.1f %8.1f %7zu\n",
+                  actors, budget, result.updateMeanUs, result.updateP99Us,
+                  result.updateMaxUs, result.sensedPerSecond, result.nearAgeMs,
+                  result.farAgeMs, result.readNs, result.dropped);
+      std::fflush(stdout);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// Helpers shared by the raysense-bench tools.
+
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace bench {
+using Clock = std::chrono::steady_clock;
+
+// Busy waits a_us, standing in for a ray cast or a physics step.
+inline void Spin(double a_us) {
+  const auto end = Clock::now() + std::chrono::nanoseconds(
+                                       static_cast<long long>(a_us * 1000.0));
+  while (Clock::now() < end) {
+  }
+}
+
+inline double Seconds(Clock::time_point a_start) {
+  return std::chrono::duration<double>(Clock::now() - a_start).count();
+}
+
+// Comma-separated unsigned values, as in --threads 1,4,16
+inline std::vector<unsigned> ParseList(const char *a_value) {
+  std::vector<unsigned> values;
+  std::stringstream stream(a_value);
+  for (std::string item; std::getline(stream, item, ',');)
+    values.push_back(
+        static_cast<unsigned>(std::strtoul(item.c_str(), nullptr, 10)));
+  return values;
+}
+} // namespace bench
@@ -0,0 +1,423 @@
+// raysense-bench: condition evaluation path under thread contention.
+//
+// OAR evaluates RaySense conditions on behavior graph threads while
+// OnUpdate publishes new sensor values on the main thread. This benchmark
+// replays that pattern with stub OAR condition components: 1-16 reader
+// threads run EvaluateImpl/GetCurrent against one writer publishing at a
+// fixed rate, for several ways of publishing the sensor values.
+//
+// Usage: raysense-bench [--seconds S] [--threads 1,4,16] [--hz 60,240,0]
+//                       [--schemes atomics,padded,seqlock,buffer]
+//        --hz 0 means the writer publishes continuously (worst case); the
+//        triple buffer is skipped there, see BufferScheme.
+
+#include "../../src/SensorChannels.h"
+#include "common.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+using bench::Clock;
+using bench::ParseList;
+using bench::Seconds;
+
+constexpr std::size_t CACHE_LINE = 64;
+// Readers time batches rather than single calls to keep clock overhead out
+// of the numbers.
+constexpr std::size_t BATCH = 256;
+
+// --- Stub OAR condition components ---------------------------------------
+
+enum class ComparisonOperator : std::uint8_t {
+  kEqual,
+  kNotEqual,
+  kGreater,
+  kGreaterEqual,
+  kLess,
+  kLessEqual
+};
+
+struct StubComparisonComponent {
+  ComparisonOperator op{ComparisonOperator::kLess};
+  bool GetComparisonResult(float a_lhs, float a_rhs) const {
+    switch (op) {
+    case ComparisonOperator::kEqual:
+      return a_lhs == a_rhs;
+    case ComparisonOperator::kNotEqual:
+      return a_lhs != a_rhs;
+    case ComparisonOperator::kGreater:
+      return a_lhs > a_rhs;
+    case ComparisonOperator::kGreaterEqual:
+      return a_lhs >= a_rhs;
+    case ComparisonOperator::kLess:
+      return a_lhs < a_rhs;
+    case ComparisonOperator::kLessEqual:
+      return a_lhs <= a_rhs;
+    }
+    return false;
+  }
+};
+
+struct StubNumericComponent {
+  float value{0.0f};
+  float GetNumericValue(const void *) const { return value; }
+};
+
+// --- Publication schemes --------------------------------------------------
+
+// Current RaySenseLogic layout: one relaxed atomic per channel, packed.
+struct AtomicsScheme {
+  static constexpr const char *NAME = "atomics";
+  static constexpr bool CONTINUOUS = true;
+  std::array<std::atomic<float>, CHANNEL_COUNT> values{};
+
+  void Publish(const std::array<float, CHANNEL_COUNT> &a_frame) {
+    for (std::size_t i = 0; i < CHANNEL_COUNT; ++i)
+      values[i].store(a_frame[i], std::memory_order_relaxed);
+  }
+  float Read(std::size_t a_channel) const {
+    return values[a_channel].load(std::memory_order_relaxed);
+  }
+  // Two channels from one Publish; may mix frames.
+  std::pair<float, float> ReadPair(std::size_t a_lhs, std::size_t a_rhs) const {
+    return {Read(a_lhs), Read(a_rhs)};
+  }
+};
+
+// Same atomics, one cache line each, so a write to one channel never
+// invalidates a reader's line for another.
+struct PaddedAtomicsScheme {
+  static constexpr const char *NAME = "padded";
+  static constexpr bool CONTINUOUS = true;
+  struct alignas(CACHE_LINE) Slot {
+    std::atomic<float> value{0.0f};
+  };
+  std::array<Slot, CHANNEL_COUNT> values{};
+
+  void Publish(const std::array<float, CHANNEL_COUNT> &a_frame) {
+    for (std::size_t i = 0; i < CHANNEL_COUNT; ++i)
+      values[i].value.store(a_frame[i], std::memory_order_relaxed);
+  }
+  float Read(std::size_t a_channel) const {
+    return values[a_channel].value.load(std::memory_order_relaxed);
+  }
+  std::pair<float, float> ReadPair(std::size_t a_lhs, std::size_t a_rhs) const {
+    return {Read(a_lhs), Read(a_rhs)};
+  }
+};
+
+// Sequence lock around a plain snapshot: readers retry while a write is in
+// flight and always see one consistent frame.
+struct SeqlockScheme {
+  static constexpr const char *NAME = "seqlock";
+  static constexpr bool CONTINUOUS = true;
+  alignas(CACHE_LINE) std::atomic<std::uint32_t> sequence{0};
+  std::array<std::atomic<float>, CHANNEL_COUNT> values{};
+
+  void Publish(const std::array<float, CHANNEL_COUNT> &a_frame) {
+    const auto seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < CHANNEL_COUNT; ++i)
+      values[i].store(a_frame[i], std::memory_order_relaxed);
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+  float Read(std::size_t a_channel) const {
+    return ReadPair(a_channel, a_channel).first;
+  }
+  std::pair<float, float> ReadPair(std::size_t a_lhs, std::size_t a_rhs) const {
+    for (;;) {
+      const auto before = sequence.load(std::memory_order_acquire);
+      if (before & 1)
+        continue;
+      const float lhs = values[a_lhs].load(std::memory_order_relaxed);
+      const float rhs = values[a_rhs].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == before)
+        return {lhs, rhs};
+    }
+  }
+};
+
+// Triple buffer: the writer fills a free snapshot and publishes its index.
+// Readers never retry, at the cost of one extra indirection.
+struct BufferScheme {
+  static constexpr const char *NAME = "buffer";
+  // A reader still on the slot the writer wraps around to reads a torn
+  // frame. Back-to-back publishing wraps within a read, so the scheme only
+  // holds at a real publication rate.
+  static constexpr bool CONTINUOUS = false;
+  struct alignas(CACHE_LINE) Snapshot {
+    std::array<std::atomic<float>, CHANNEL_COUNT> values{};
+  };
+  std::array<Snapshot, 3> snapshots{};
+  alignas(CACHE_LINE) std::atomic<std::uint32_t> current{0};
+
+  void Publish(const std::array<float, CHANNEL_COUNT> &a_frame) {
+    // With one writer and publication intervals far longer than a read, the
+    // slot after the current one is never being read.
+    const auto next = (current.load(std::memory_order_relaxed) + 1) % 3;
+    for (std::size_t i = 0; i < CHANNEL_COUNT; ++i)
+      snapshots[next].values[i].store(a_frame[i], std::memory_order_relaxed);
+    current.store(next, std::memory_order_release);
+  }
+  float Read(std::size_t a_channel) const {
+    return snapshots[current.load(std::memory_order_acquire)]
+        .values[a_channel]
+        .load(std::memory_order_relaxed);
+  }
+  std::pair<float, float> ReadPair(std::size_t a_lhs, std::size_t a_rhs) const {
+    const auto &snapshot = snapshots[current.load(std::memory_order_acquire)];
+    return {snapshot.values[a_lhs].load(std::memory_order_relaxed),
+            snapshot.values[a_rhs].load(std::memory_order_relaxed)};
+  }
+};
+
+// --- Stub conditions ------------------------------------------------------
+
+struct StubCondition {
+  std::size_t channel;
+  StubComparisonComponent comparison;
+  StubNumericComponent value;
+};
+
+template <class Scheme>
+bool EvaluateImpl(const Scheme &a_scheme, const StubCondition &a_condition) {
+  return a_condition.comparison.GetComparisonResult(
+      a_scheme.Read(a_condition.channel),
+      a_condition.value.GetNumericValue(nullptr));
+}
+
+template <class Scheme>
+std::size_t GetCurrent(const Scheme &a_scheme,
+                       const StubCondition &a_condition) {
+  float val = a_scheme.Read(a_condition.channel);
+  if (!std::isfinite(val))
+    return 1;
+  return std::to_string(static_cast<int>(val)).size();
+}
+
+// --- Runner ---------------------------------------------------------------
+
+struct Result {
+  double evalsPerSecond{0.0};
+  double p50Ns{0.0};
+  double p99Ns{0.0};
+  double maxNs{0.0};
+  std::uint64_t tornPairs{0};
+  std::uint64_t pairReads{0};
+  std::uint64_t publishes{0};
+};
+
+enum class Operation { kEvaluate, kGetCurrent };
+
+template <class Scheme>
+Result Run(unsigned a_readers, unsigned a_hz, double a_seconds,
+           Operation a_operation) {
+  auto scheme = std::make_unique<Scheme>();
+  std::atomic<bool> running{true};
+  std::atomic<unsigned> ready{0};
+
+  // Every published frame stores the frame number in every channel, so a
+  // pair read from two different frames is detectable.
+  std::atomic<std::uint64_t> publishes{0};
+  std::thread writer([&] {
+    std::array<float, CHANNEL_COUNT> frame{};
+    const auto interval =
+        a_hz ? std::chrono::nanoseconds(1'000'000'000 / a_hz)
+             : std::chrono::nanoseconds(0);
+    auto next = Clock::now();
+    std::uint64_t count = 0;
+    while (ready.load(std::memory_order_acquire) < a_readers)
+      std::this_thread::yield();
+    while (running.load(std::memory_order_relaxed)) {
+      frame.fill(static_cast<float>(++count % 4096));
+      scheme->Publish(frame);
+      if (a_hz) {
+        next += interval;
+        std::this_thread::sleep_until(next);
+      }
+    }
+    publishes.store(count, std::memory_order_relaxed);
+  });
+
+  std::vector<StubCondition> conditions;
+  for (std::size_t i = 0; i < CHANNEL_COUNT; ++i) {
+    StubCondition condition{i, {}, {}};
+    condition.comparison.op = static_cast<ComparisonOperator>(i % 6);
+    condition.value.value = static_cast<float>(i * 100);
+    conditions.push_back(condition);
+  }
+
+  struct ReaderResult {
+    std::vector<double> batchNs;
+    std::uint64_t evals{0};
+    std::uint64_t torn{0};
+    std::uint64_t pairs{0};
+    std::uint64_t sink{0};
+  };
+  std::vector<ReaderResult> results(a_readers);
+  std::vector<std::thread> readers;
+
+  for (unsigned r = 0; r < a_readers; ++r) {
+    readers.emplace_back([&, r] {
+      auto &result = results[r];
+      result.batchNs.reserve(1 << 16);
+      std::size_t index = r;
+      ready.fetch_add(1, std::memory_order_release);
+      while (running.load(std::memory_order_relaxed)) {
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < BATCH; ++i) {
+          const auto &condition = conditions[index++ % CHANNEL_COUNT];
+          if (a_operation == Operation::kEvaluate)
+            result.sink += EvaluateImpl(*scheme, condition);
+          else
+            result.sink += GetCurrent(*scheme, condition);
+        }
+        const auto end = Clock::now();
+        if (result.batchNs.size() < result.batchNs.capacity())
+          result.batchNs.push_back(
+              std::chrono::duration<double, std::nano>(end - start).count() /
+              BATCH);
+        result.evals += BATCH;
+
+        // Cross-channel consistency probe, e.g. an obstacle distance paired
+        // with the wall distance it was derived from.
+        const auto [lhs, rhs] = scheme->ReadPair(6, 7);
+        result.torn += lhs != rhs;
+        ++result.pairs;
+      }
+    });
+  }
+
+  while (ready.load(std::memory_order_acquire) < a_readers)
+    std::this_thread::yield();
+  const auto start = Clock::now();
+  std::this_thread::sleep_for(std::chrono::duration<double>(a_seconds));
+  running.store(false, std::memory_order_relaxed);
+  const auto elapsed = Seconds(start);
+
+  for (auto &reader : readers)
+    reader.join();
+  writer.join();
+
+  Result result;
+  std::vector<double> samples;
+  std::uint64_t evals = 0;
+  for (auto &reader : results) {
+    samples.insert(samples.end(), reader.batchNs.begin(),
+                   reader.batchNs.end());
+    evals += reader.evals;
+    result.tornPairs += reader.torn;
+    result.pairReads += reader.pairs;
+  }
+  std::sort(samples.begin(), samples.end());
+  if (!samples.empty()) {
+    result.p50Ns = samples[samples.size() / 2];
+    result.p99Ns = samples[samples.size() * 99 / 100];
+    result.maxNs = samples.back();
+  }
+  result.evalsPerSecond = evals / elapsed;
+  result.publishes = publishes.load(std::memory_order_relaxed);
+  return result;
+}
+
+std::vector<std::string> ParseNames(const char *a_value) {
+  std::vector<std::string> values;
+  std::stringstream stream(a_value);
+  for (std::string item; std::getline(stream, item, ',');)
+    values.push_back(item);
+  return values;
+}
+
+template <class Scheme>
+void RunMatrix(const std::vector<unsigned> &a_threads,
+               const std::vector<unsigned> &a_rates, double a_seconds) {
+  for (auto operation : {Operation::kEvaluate, Operation::kGetCurrent}) {
+    for (auto hz : a_rates) {
+      if (!hz && !Scheme::CONTINUOUS) {
+        if (operation == Operation::kEvaluate)
+          std::fprintf(stderr,
+                       "raysense-bench: %s needs a publication rate, "
+                       "skipping --hz 0\n",
+                       Scheme::NAME);
+        continue;
+      }
+      for (auto readers : a_threads) {
+        const auto result = Run<Scheme>(readers, hz, a_seconds, operation);
+        std::printf("%-8s %-10s %5s %7u %14.0f %8.1f %8.1f %9.1f %10.4f%%\n",
+                    Scheme::NAME,
+                    operation == Operation::kEvaluate ? "Evaluate"
+                                                      : "GetCurrent",
+                    hz ? std::to_string(hz).c_str() : "max", readers,
+                    result.evalsPerSecond, result.p50Ns, result.p99Ns,
+                    result.maxNs,
+                    result.pairReads
+                        ? 100.0 * result.tornPairs / result.pairReads
+                        : 0.0);
+        std::fflush(stdout);
+      }
+    }
+  }
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  double seconds = 0.5;
+  std::vector<unsigned> threads{1, 2, 4, 8, 16};
+  std::vector<unsigned> rates{60, 240, 0};
+  std::vector<std::string> schemes{"atomics", "padded", "seqlock", "buffer"};
+
+  for (int i = 1; i < argc; ++i) {
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!std::strcmp(argv[i], "--seconds") && value) {
+      seconds = std::max(0.05, std::atof(value));
+      ++i;
+    } else if (!std::strcmp(argv[i], "--threads") && value) {
+      threads = ParseList(value);
+      ++i;
+    } else if (!std::strcmp(argv[i], "--hz") && value) {
+      rates = ParseList(value);
+      ++i;
+    } else if (!std::strcmp(argv[i], "--schemes") && value) {
+      schemes = ParseNames(value);
+      ++i;
+    } else {
+      std::fprintf(stderr,
+                   "usage: raysense-bench [--seconds S] [--threads 1,4,16] "
+                   "[--hz 60,240,0] "
+                   "[--schemes atomics,padded,seqlock,buffer]\n");
+      return 2;
+    }
+  }
+
+  std::printf("%-8s %-10s %5s %7s %14s %8s %8s %9s %11s\n", "Scheme", "Op",
+              "Hz", "Readers", "Evals/s", "p50(ns)", "p99(ns)", "max(ns)",
+              "Torn pairs");
+  for (const auto &scheme : schemes) {
+    if (scheme == AtomicsScheme::NAME)
+      RunMatrix<AtomicsScheme>(threads, rates, seconds);
+    else if (scheme == PaddedAtomicsScheme::NAME)
+      RunMatrix<PaddedAtomicsScheme>(threads, rates, seconds);
+    else if (scheme == SeqlockScheme::NAME)
+      RunMatrix<SeqlockScheme>(threads, rates, seconds);
+    else if (scheme == BufferScheme::NAME)
+      RunMatrix<BufferScheme>(threads, rates, seconds);
+    else
+      std::fprintf(stderr, "raysense-bench: unknown scheme %s\n",
+                   scheme.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,184 @@
+// raysense-pool-bench: single-thread vs pooled player sensor sweep.
+//
+// Replays the sweep RaySenseLogic fans out on its SensorPool, job for job
+// as in SweepPooled: the sensor array (--array-rays, back to back), the
+// obstacle pass (six rays), landing prediction (--landing-rays), then front,
+// player height, left and right verticality and three obstacle-type rays
+// (one ray each). Each ray takes a shared lock standing in for the Havok
+// world read lock and busy waits --ray-us.
+// An optional physics thread takes the same lock exclusively, like the
+// engine stepping the world. Sweeps are paced like frames so helpers go to
+// sleep between them, as they do in game.
+//
+// Usage: raysense-pool-bench [--seconds S] [--threads 1,2,3,4] [--ray-us U]
+//                            [--hz 60] [--physics-us U] [--array-rays N]
+//                            [--landing-rays N]
+//        --hz 0 runs sweeps back to back.
+
+#include "../../src/SensorPool.h"
+#include "common.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+using bench::Clock;
+using bench::ParseList;
+using bench::Seconds;
+using bench::Spin;
+
+// Rays per job in the order of SweepPooled's JOBS[]; the array and landing
+// jobs are set from the options
+constexpr unsigned JOB_RAYS[] = {0, 6, 0, 1, 1, 1, 1, 1, 1, 1};
+constexpr unsigned JOB_COUNT = std::size(JOB_RAYS);
+constexpr unsigned ARRAY_JOB = 0;
+constexpr unsigned LANDING_JOB = 2;
+
+struct Options {
+  double seconds{2.0};
+  std::vector<unsigned> threads{1, 2, 3, 4};
+  double rayUs{3.0};
+  unsigned hz{60};
+  double physicsUs{0.0};
+  unsigned arrayRays{0};   // [Array] off by default
+  unsigned landingRays{1}; // A short hop; a long fall casts up to 16
+};
+
+struct Result {
+  double meanUs{0.0};
+  double p50Us{0.0};
+  double p99Us{0.0};
+  double maxUs{0.0};
+  std::size_t sweeps{0};
+};
+
+Result Run(const Options &a_options, unsigned a_threads) {
+  SensorPool pool;
+  pool.Start(a_threads);
+
+  std::shared_mutex worldLock;
+  std::atomic<bool> stop{false};
+  std::thread physics;
+  if (a_options.physicsUs > 0.0) {
+    // Steps the world at 60 Hz while holding the lock exclusively
+    physics = std::thread([&] {
+      auto next = Clock::now();
+      while (!stop.load(std::memory_order_relaxed)) {
+        {
+          std::unique_lock lock(worldLock);
+          Spin(a_options.physicsUs);
+        }
+        next += std::chrono::microseconds(16667);
+        std::this_thread::sleep_until(next);
+      }
+    });
+  }
+
+  std::array<unsigned, JOB_COUNT> jobRays{};
+  std::copy(std::begin(JOB_RAYS), std::end(JOB_RAYS), jobRays.begin());
+  jobRays[ARRAY_JOB] = a_options.arrayRays;
+  jobRays[LANDING_JOB] = a_options.landingRays;
+
+  std::vector<double> sweepUs;
+  std::array<float, JOB_COUNT> values{};
+  const auto start = Clock::now();
+  auto nextFrame = start;
+  while (Seconds(start) < a_options.seconds) {
+    const auto sweepStart = Clock::now();
+    pool.Run(JOB_COUNT, [&](std::uint32_t a_job) {
+      for (unsigned ray = 0; ray < jobRays[a_job]; ++ray) {
+        std::shared_lock lock(worldLock);
+        Spin(a_options.rayUs);
+      }
+      values[a_job] = static_cast<float>(a_job);
+    });
+    sweepUs.push_back(
+        std::chrono::duration<double, std::micro>(Clock::now() - sweepStart)
+            .count());
+
+    if (a_options.hz) {
+      nextFrame += std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(1.0 / a_options.hz));
+      std::this_thread::sleep_until(nextFrame);
+    }
+  }
+
+  stop.store(true, std::memory_order_relaxed);
+  if (physics.joinable())
+    physics.join();
+
+  Result result;
+  std::sort(sweepUs.begin(), sweepUs.end());
+  for (auto us : sweepUs)
+    result.meanUs += us;
+  result.sweeps = sweepUs.size();
+  result.meanUs /= std::max<std::size_t>(sweepUs.size(), 1);
+  result.p50Us = sweepUs[sweepUs.size() / 2];
+  result.p99Us = sweepUs[sweepUs.size() * 99 / 100];
+  result.maxUs = sweepUs.back();
+  return result;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!std::strcmp(argv[i], "--seconds") && value) {
+      options.seconds = std::max(0.2, std::atof(value));
+      ++i;
+    } else if (!std::strcmp(argv[i], "--threads") && value) {
+      options.threads = ParseList(value);
+      ++i;
+    } else if (!std::strcmp(argv[i], "--ray-us") && value) {
+      options.rayUs = std::max(0.0, std::atof(value));
+      ++i;
+    } else if (!std::strcmp(argv[i], "--hz") && value) {
+      options.hz = static_cast<unsigned>(std::max(0, std::atoi(value)));
+      ++i;
+    } else if (!std::strcmp(argv[i], "--physics-us") && value) {
+      options.physicsUs = std::max(0.0, std::atof(value));
+      ++i;
+    } else if (!std::strcmp(argv[i], "--array-rays") && value) {
+      options.arrayRays = std::min(
+          static_cast<unsigned>(std::max(0, std::atoi(value))), 64u);
+      ++i;
+    } else if (!std::strcmp(argv[i], "--landing-rays") && value) {
+      options.landingRays = std::min(
+          static_cast<unsigned>(std::max(0, std::atoi(value))), 16u);
+      ++i;
+    } else {
+      std::fprintf(stderr,
+                   "usage: raysense-pool-bench [--seconds S] "
+                   "[--threads 1,2,3,4] [--ray-us U] [--hz 60] "
+                   "[--physics-us U] [--array-rays N] "
+                   "[--landing-rays N]\n");
+      return 2;
+    }
+  }
+
+  std::printf("%7s %8s %9s %9s %9s %9s %8s\n", "Threads", "Sweeps",
+              "Mean us", "p50 us", "p99 us", "Max us", "Speedup");
+  double serialMean = 0.0;
+  for (auto threads : options.threads) {
+    const auto result = Run(options, threads);
+    if (threads <= 1)
+      serialMean = result.meanUs;
+    std::printf("%7u %8zu %9.1f %9.1f %9.1f %9.1f %7.2fx\n",
+                std::max(threads, 1u), result.sweeps, result.meanUs,
+                result.p50Us, result.p99Us, result.maxUs,
+                serialMean > 0.0 ? serialMean / result.meanUs : 1.0);
+    std::fflush(stdout);
+  }
+  return 0;
+}
@@ -0,0 +1,237 @@
+// raysense-heatmap: merges RaySense_Heatmap_*.csv files from several play
+// sessions and ranks the locations where sensing is most expensive.
+//
+// Usage: raysense-heatmap [--sort mean|max|rays|fallback|lock] [--top N]
+//                         [--min-frames N] [--by-cell] FILE...
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Key {
+  std::string worldSpace;
+  std::string cell;
+  std::int32_t tileX{0};
+  std::int32_t tileY{0};
+
+  bool operator<(const Key &a_rhs) const {
+    return std::tie(worldSpace, cell, tileX, tileY) <
+           std::tie(a_rhs.worldSpace, a_rhs.cell, a_rhs.tileX, a_rhs.tileY);
+  }
+};
+
+struct Stats {
+  bool interior{false};
+  std::uint64_t frames{0};
+  std::uint64_t totalUs{0};
+  std::uint64_t maxUs{0};
+  std::uint64_t rays{0};
+  std::uint64_t fallbacks{0};
+  std::uint64_t lockWaitUs{0};
+  std::uint32_t sessions{0};
+
+  double MeanUs() const { return frames ? double(totalUs) / frames : 0.0; }
+  double RaysPerFrame() const { return frames ? double(rays) / frames : 0.0; }
+  double FallbackRate() const {
+    return rays ? double(fallbacks) / double(rays + fallbacks) : 0.0;
+  }
+  double LockWaitUs() const {
+    return frames ? double(lockWaitUs) / frames : 0.0;
+  }
+};
+
+struct Options {
+  std::string sort{"mean"};
+  std::size_t top{25};
+  std::uint64_t minFrames{60};
+  bool byCell{false};
+  std::vector<std::string> files;
+};
+
+void PrintUsage() {
+  std::cerr << "usage: raysense-heatmap [--sort mean|max|rays|fallback|lock] "
+               "[--top N] [--min-frames N] [--by-cell] FILE...\n";
+}
+
+bool ParseArgs(int a_argc, char **a_argv, Options &a_options) {
+  for (int i = 1; i < a_argc; ++i) {
+    std::string arg = a_argv[i];
+    auto next = [&]() -> const char * {
+      return i + 1 < a_argc ? a_argv[++i] : nullptr;
+    };
+
+    if (arg == "--sort") {
+      const char *value = next();
+      if (!value)
+        return false;
+      a_options.sort = value;
+    } else if (arg == "--top") {
+      const char *value = next();
+      if (!value)
+        return false;
+      a_options.top = std::strtoull(value, nullptr, 10);
+    } else if (arg == "--min-frames") {
+      const char *value = next();
+      if (!value)
+        return false;
+      a_options.minFrames = std::strtoull(value, nullptr, 10);
+    } else if (arg == "--by-cell") {
+      a_options.byCell = true;
+    } else if (arg == "-h" || arg == "--help") {
+      return false;
+    } else {
+      a_options.files.push_back(arg);
+    }
+  }
+
+  static const char *SORTS[] = {"mean", "max", "rays", "fallback", "lock"};
+  const bool validSort =
+      std::any_of(std::begin(SORTS), std::end(SORTS),
+                  [&](const char *a_sort) { return a_options.sort == a_sort; });
+  return validSort && !a_options.files.empty();
+}
+
+// Whole-field decimal number; false on anything else, including overflow
+template <class T> bool ParseNumber(const std::string &a_field, T &a_value) {
+  const char *end = a_field.data() + a_field.size();
+  const auto [ptr, ec] = std::from_chars(a_field.data(), end, a_value);
+  return ec == std::errc() && ptr == end;
+}
+
+// Reads one session file. Returns the number of rows merged, or -1. Rows
+// with the wrong field count or a malformed number are counted in
+// a_skipped and left out.
+long LoadFile(const std::string &a_path, bool a_byCell,
+              std::map<Key, Stats> &a_stats, std::uint64_t &a_skipped) {
+  std::ifstream file(a_path);
+  if (!file.is_open())
+    return -1;
+
+  std::string line;
+  if (!std::getline(file, line) || line.rfind("worldspace,", 0) != 0)
+    return -1;
+
+  long rows = 0;
+  std::map<Key, bool> seen;
+  while (std::getline(file, line)) {
+    if (line.empty())
+      continue;
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    for (std::string field; std::getline(stream, field, ',');)
+      fields.push_back(field);
+    if (fields.size() != 11) {
+      ++a_skipped;
+      continue;
+    }
+
+    Key key{fields[0], fields[1]};
+    std::uint64_t counts[6];
+    bool valid = ParseNumber(fields[2], key.tileX) &&
+                 ParseNumber(fields[3], key.tileY);
+    for (std::size_t i = 0; valid && i < std::size(counts); ++i)
+      valid = ParseNumber(fields[5 + i], counts[i]);
+    if (!valid) {
+      ++a_skipped;
+      continue;
+    }
+    if (a_byCell)
+      key.tileX = key.tileY = 0;
+
+    auto &stats = a_stats[key];
+    stats.interior = fields[4] == "1";
+    stats.frames += counts[0];
+    stats.totalUs += counts[1];
+    stats.maxUs = std::max(stats.maxUs, counts[2]);
+    stats.rays += counts[3];
+    stats.fallbacks += counts[4];
+    stats.lockWaitUs += counts[5];
+    if (!seen[key]) {
+      seen[key] = true;
+      ++stats.sessions;
+    }
+    ++rows;
+  }
+  return rows;
+}
+
+double SortValue(const Stats &a_stats, const std::string &a_sort) {
+  if (a_sort == "max")
+    return double(a_stats.maxUs);
+  if (a_sort == "rays")
+    return a_stats.RaysPerFrame();
+  if (a_sort == "fallback")
+    return a_stats.FallbackRate();
+  if (a_sort == "lock")
+    return a_stats.LockWaitUs();
+  return a_stats.MeanUs();
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!ParseArgs(argc, argv, options)) {
+    PrintUsage();
+    return 2;
+  }
+
+  std::map<Key, Stats> stats;
+  for (const auto &path : options.files) {
+    std::uint64_t skipped = 0;
+    if (LoadFile(path, options.byCell, stats, skipped) < 0) {
+      std::cerr << "raysense-heatmap: cannot read " << path << "\n";
+      return 1;
+    }
+    if (skipped)
+      std::cerr << "raysense-heatmap: skipped " << skipped
+                << " malformed rows in " << path << "\n";
+  }
+
+  std::vector<std::pair<Key, Stats>> ranked;
+  std::uint64_t totalFrames = 0;
+  for (const auto &entry : stats) {
+    totalFrames += entry.second.frames;
+    if (entry.second.frames >= options.minFrames)
+      ranked.push_back(entry);
+  }
+
+  std::sort(ranked.begin(), ranked.end(),
+            [&](const auto &a_lhs, const auto &a_rhs) {
+              return SortValue(a_lhs.second, options.sort) >
+                     SortValue(a_rhs.second, options.sort);
+            });
+
+  std::printf("%zu files, %zu locations, %llu frames (ranked by %s, "
+              ">= %llu frames)\n\n",
+              options.files.size(), stats.size(),
+              static_cast<unsigned long long>(totalFrames),
+              options.sort.c_str(),
+              static_cast<unsigned long long>(options.minFrames));
+  std::printf("%4s  %-8s %-8s %7s %7s %3s %9s %9s %8s %8s %9s %8s\n", "Rank",
+              "World", "Cell", "TileX", "TileY", "Int", "Mean(us)", "Max(us)",
+              "Rays/fr", "Fallback", "Lock(us)", "Frames");
+
+  const auto count = std::min(options.top, ranked.size());
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto &[key, entry] = ranked[i];
+    std::printf("%4zu  %-8s %-8s %7d %7d %3s %9.1f %9llu %8.2f %7.2f%% "
+                "%9.2f %8llu\n",
+                i + 1, key.worldSpace.c_str(), key.cell.c_str(), key.tileX,
+                key.tileY, entry.interior ? "yes" : "no", entry.MeanUs(),
+                static_cast<unsigned long long>(entry.maxUs),
+                entry.RaysPerFrame(), entry.FallbackRate() * 100.0,
+                entry.LockWaitUs(),
+                static_cast<unsigned long long>(entry.frames));
+  }
+  return 0;
+}